@@ -23,13 +23,18 @@
 #define QDEC_MAX 9
 
 #include <stdint.h>
+#include "FpLiteral.hpp"
+#include "FpMul.hpp"
+#include "FpDiv.hpp"
+#include "FpFloat.hpp"
+#include "FpChars.hpp"
 
 namespace Fp
 {
 // Luck-up table to calculate number of decimal digits depending on chosen q (fractional binary digits)
 // formula used for qd = ROUND(LOG(2^q;10))
-static const uint8_t qd_lut[] = {0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9};
-static const uint32_t power10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+static constexpr uint8_t qd_lut[] = {0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9};
+static constexpr uint32_t power10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 
 //! The template argument p in all of the following functions refers to the
 //! fixed point precision (e.g. p = 8 gives 24.8 fixed point functions).
@@ -42,6 +47,15 @@ private:
         qd = qd_lut[q];
     }
 
+    struct RawTag {};
+
+    constexpr Fp32s(RawTag, int32_t raw, uint8_t qin) :
+        rawVal(raw),
+        q(qin),
+        qd(qd_lut[qin])
+    {
+    }
+
 public:
 
     //! @brief        The fixed-point number is stored in this basic data type.
@@ -56,16 +70,22 @@ public:
     {
     }
 
-    Fp32s(int32_t i, uint8_t qin)
+    // Constructors are constexpr, so constants are built by the compiler.
+    // Shifts are done on unsigned values: left shift of a negative number
+    // is not allowed in constant expressions (same bits at runtime).
+    constexpr Fp32s(int32_t i, uint8_t qin) :
+        rawVal((int32_t)((uint32_t)i << qin)),
+        q(qin),
+        qd(qd_lut[qin])
     {
-        rawVal = i << qin;
-        _set_q(qin);
     }
 
-    Fp32s(double dbl, uint8_t qin)
+    //! @note        Rounded toward zero, on AVR built from the float bits and saturated (FpFloat.hpp).
+    constexpr Fp32s(double dbl, uint8_t qin) :
+        rawVal(detail::double_to_fix32(dbl, qin)),
+        q(qin),
+        qd(qd_lut[qin])
     {
-        rawVal = (int32_t)(dbl * (1 << qin));
-        _set_q(qin);
     }
 
     //  To get the FixPoint number (e.g 123.0045)- set separately:
@@ -73,10 +93,35 @@ public:
     //  fractional part integer: 45
     //  fractional part divider: 10000
     //  fractional bits: 13 (13 binary bits ~ 4 decimal digits)
-    Fp32s(int32_t ipart, uint32_t fpart_i, uint32_t fpart_d, uint8_t qin)
+    constexpr Fp32s(int32_t ipart, uint32_t fpart_i, uint32_t fpart_d, uint8_t qin) :
+        rawVal((int32_t)(((uint32_t)ipart << qin) + (fpart_i << qin) / fpart_d)),
+        q(qin),
+        qd(qd_lut[qin])
+    {
+    }
+
+    //! @brief        Builds the number from the raw value (no shift).
+    static constexpr Fp32s from_raw(int32_t raw, uint8_t qin)
+    {
+        return Fp32s(RawTag(), raw, qin);
+    }
+
+    //! @brief        Builds the number from a float without soft-float code,
+    //!             rounded as asked and saturated (see FpFloat.hpp).
+    static Fp32s from_float(float f, uint8_t qin, FloatRound round = ROUND_NEAREST)
     {
-        rawVal = (ipart << qin) + (fpart_i << qin) / fpart_d;
-        _set_q(qin);
+        return Fp32s(RawTag(), detail::float_to_fix32_bits(f, qin, round), qin);
+    }
+
+    //! @brief        Parses decimal text "[+|-]digits[.digits]" (len chars at most),
+    //!             rounded to nearest and saturated, 0 if s does not start with a number.
+    //! @details    No float or division (FpChars.hpp), parsing stops at the first
+    //!             character that does not fit.
+    static Fp32s from_chars(const char *s, uint8_t len, uint8_t qin)
+    {
+        int32_t raw;
+        detail::chars_to_fix32(s, len, qin, raw);
+        return Fp32s(RawTag(), raw, qin);
     }
 
     // Compound Arithmetic Operators
@@ -136,7 +181,8 @@ public:
     }
 
     //! @brief        Overlaod for '*=' operator.
-    //! @details    Uses intermediatary casting to int64_t to prevent overflows.
+    //! @details    Same result as casting to int64_t to prevent overflows, the 32x32->64
+    //!             multiplication and the shift are done by detail::mul32_shr (FpMul.hpp).
     Fp32s& operator *= (Fp32s r)
     {
         // Optimised for when q is the same for both
@@ -144,48 +190,56 @@ public:
         if(q == r.q)
         {
             // Q the same for both numbers, shift right by Q
-            rawVal = (int32_t)(((int64_t)rawVal * (int64_t)r.rawVal) >> q);
+            rawVal = detail::mul32_shr(rawVal, r.rawVal, q);
             // No need to change Q, both are the same
         }
         else if(q > r.q)
         {
             // Second number has smaller Q, so result is in that precision
-            rawVal = (int32_t)((((int64_t)rawVal >> (q - r.q)) * (int64_t)r.rawVal) >> r.q);
+            rawVal = detail::mul32_shr(rawVal >> (q - r.q), r.rawVal, r.q);
             // Change Q
             _set_q(r.q);
         }
         else // q < r.q
         {
             // First number has smaller Q, so result is in that precision
-            rawVal = (int32_t)(((int64_t)rawVal * ((int64_t)r.rawVal >> (r.q - q))) >> q);
+            rawVal = detail::mul32_shr(rawVal, r.rawVal >> (r.q - q), q);
             // No need to change Q
         }
         return *this;
     }
 
     //! @brief        Overlaod for '/=' operator.
-    //! @details    Uses intermediatary casting to int64_t to prevent overflows.
+    //! @details    Reciprocal division of FpDiv.hpp with the FP_DIV_MODE accuracy,
+    //!             by default the same result as the int64_t division.
     Fp32s& operator /= (Fp32s r)
+    {
+        return div<FP_DIV_MODE>(r);
+    }
+
+    //! @brief        Division with the given accuracy (see DivMode in FpDiv.hpp).
+    template <DivMode mode>
+    Fp32s& div(Fp32s r)
     {
         // Optimised for when q is the same for both
         // operators (first if statement).
         if(q == r.q)
         {
-            // Q the same for both numbers, shift right by Q
-            rawVal = (int32_t)((((int64_t)rawVal << q) / (int64_t)r.rawVal));
+            // Q the same for both numbers, shift left by Q
+            rawVal = detail::div32_shl(rawVal, r.rawVal, q, mode);
             // No need to change Q, both are the same
         }
         else if(q > r.q)
         {
             // Second number has smaller Q, so result is in that precision
-            rawVal = (int32_t)(((((int64_t)rawVal >> (q - r.q)) << r.q) / (int64_t)r.rawVal));
+            rawVal = detail::div32_shl(rawVal >> (q - r.q), r.rawVal, r.q, mode);
             // Change Q
             _set_q(r.q);
         }
         else // q < r.q
         {
             // First number has smaller Q, so result is in that precision
-            rawVal = (int32_t)(((int64_t)rawVal << q) / ((int64_t)r.rawVal >> (r.q - q)));
+            rawVal = detail::div32_shl(rawVal, r.rawVal >> (r.q - q), q, mode);
             // No need to change Q
         }
         return *this;
@@ -220,6 +274,12 @@ public:
 
     // Simple Arithmetic Operators
 
+    //! @brief        Overload for '-itself' operator.
+    constexpr Fp32s operator - () const
+    {
+        return from_raw((int32_t)(0 - (uint32_t)rawVal), q);
+    }
+
     //! @brief        Overload for '+' operator.
     //! @details    Uses '+=' operator.
     Fp32s operator + (Fp32s r) const
@@ -402,14 +462,14 @@ public:
     // Explicit Conversion Operator Overloads (casts)
 
     //! @brief        Conversion operator from fixed-point to int32_t.
-    operator int32_t()
+    constexpr operator int32_t() const
     {
         // Right-shift to get rid of all the decimal bits
         return (rawVal >> q);
     }
 
     //! @brief        Conversion operator from fixed-point to int64_t.
-    operator int64_t()
+    constexpr operator int64_t() const
     {
         // Right-shift to get rid of all the decimal bits
         return (int64_t)(rawVal >> q);
@@ -417,49 +477,110 @@ public:
 
     //! @brief        Conversion operator from fixed-point to float.
     //! @note        Similar to double conversion.
-    operator float()
+    constexpr operator float() const
     {
-        return (float)rawVal / (float)(1 << q);
+        return detail::fix32_to_float(rawVal, q);
     }
 
     //! @brief        Conversion operator from fixed-point to double.
     //! @note        Similar to float conversion.
-    operator double()
+    constexpr operator double() const
     {
-        return (double)rawVal / (double)(1 << q);
+        return detail::fix32_to_double(rawVal, q);
     }
 
     // Returns the integer part of the number
-    int32_t ipart()
+    constexpr int32_t ipart() const
     {
         // Right-shift to get rid of all the decimal bits
         return (rawVal >> q);
     }
 
     // Returns the fractional part of the number as integer
-    uint32_t fpart()
+    constexpr uint32_t fpart() const
     {
-        uint32_t res;
-        uint64_t res64 = (uint64_t)(rawVal % (1 << q)) * (uint64_t)fpart_divider();
-        if (qd < QDEC_MAX) {
-            res64 *= 10; // increase precision - prepare for rounding
-            res = (uint32_t)(res64 >> q);
-            // rounding the result (minus one decimal digit)
-            uint8_t rem = res % 10;
-            res = res / 10;
-            if (rem >= 5) res += 1;
-        } else {
-            res = (uint32_t)(res64 >> q);
-        }
-        return res;
+        // rounding the result (minus one decimal digit) when there is a spare decimal digit
+        return (qd < QDEC_MAX) ?
+            _round_last_digit((uint32_t)((_fpart64() * 10) >> q)) :
+            (uint32_t)(_fpart64() >> q);
     }
 
     // Returns the fractional part divider
-    uint32_t fpart_divider()
+    constexpr uint32_t fpart_divider() const
     {
         return power10[qd];
     }
+
+    //! @brief        Writes the number as decimal text with the given number of
+    //!             fractional digits (rounded) and '\0', returns the text length.
+    //! @details    No float, printf or division (FpChars.hpp). buf must hold
+    //!             13 + digits chars.
+    uint8_t to_chars(char *buf, uint8_t digits) const
+    {
+        return detail::fix32_to_chars(buf, rawVal, q, digits);
+    }
+
+private:
+    // fractional bits multiplied by the fractional part divider
+    constexpr uint64_t _fpart64() const
+    {
+        return (uint64_t)(rawVal % (int32_t)((uint32_t)1 << q)) * (uint64_t)fpart_divider();
+    }
+
+    // drops the last decimal digit, rounding half up
+    static constexpr uint32_t _round_last_digit(uint32_t res)
+    {
+        return res / 10 + ((res % 10 >= 5) ? 1 : 0);
+    }
 }; // class
+
+//! @brief        Fixed point literals: 0.01_q7 is Fp32s(0.01, 7) built by the compiler.
+//! @details    _q0 .. _q31 give the number of fractional bits. The value is rounded to
+//!             nearest, the build fails if it does not fit or rounds to zero.
+//!             Use with: using namespace Fp::literals;
+namespace literals
+{
+#define FP32S_LITERAL(Q) \
+    template <char... c> \
+    constexpr Fp32s operator"" _q##Q() \
+    { \
+        return Fp32s::from_raw((int32_t)detail::FixedLiteral<Q, 0x7fffffffUL, c...>::raw, Q); \
+    }
+
+FP32S_LITERAL(0)
+FP32S_LITERAL(1)
+FP32S_LITERAL(2)
+FP32S_LITERAL(3)
+FP32S_LITERAL(4)
+FP32S_LITERAL(5)
+FP32S_LITERAL(6)
+FP32S_LITERAL(7)
+FP32S_LITERAL(8)
+FP32S_LITERAL(9)
+FP32S_LITERAL(10)
+FP32S_LITERAL(11)
+FP32S_LITERAL(12)
+FP32S_LITERAL(13)
+FP32S_LITERAL(14)
+FP32S_LITERAL(15)
+FP32S_LITERAL(16)
+FP32S_LITERAL(17)
+FP32S_LITERAL(18)
+FP32S_LITERAL(19)
+FP32S_LITERAL(20)
+FP32S_LITERAL(21)
+FP32S_LITERAL(22)
+FP32S_LITERAL(23)
+FP32S_LITERAL(24)
+FP32S_LITERAL(25)
+FP32S_LITERAL(26)
+FP32S_LITERAL(27)
+FP32S_LITERAL(28)
+FP32S_LITERAL(29)
+FP32S_LITERAL(30)
+FP32S_LITERAL(31)
+#undef FP32S_LITERAL
+} // namespace literals
 } // namespace Fp
 
 #endif // #ifndef FP32S_H
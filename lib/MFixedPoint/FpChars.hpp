@@ -0,0 +1,274 @@
+//!
+//! @file               FpChars.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              Fixed-point to and from decimal text without float, printf or division.
+//! @details
+//!     The fraction is moved to the top of 32-bit words (0.32, or 0.64 for Fp64f),
+//!     each decimal digit is what overflows the words when they are multiplied by 10
+//!     (done on 16-bit halves, so 32-bit multiplies only). The text is rounded to
+//!     nearest, half away from zero, from the exact binary value. The integer part
+//!     is divided by 10 as a multiplication by the reciprocal 0xcccccccd / 2^35.
+//!
+//!     Parsing reads the fraction digits as an integer F with k digits and needs
+//!     F * 2^q / 10^k. The division is a multiplication by 2^(63 + b) / 10^k from a
+//!     table (b = bit length of 10^k, so all entries carry 64 significant bits),
+//!     corrected by the exact remainder. The result is rounded to nearest, half
+//!     away from zero, like the text output, and saturates like the arithmetic.
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef FP_CHARS_H
+#define FP_CHARS_H
+
+#include <stdint.h>
+#include "FpDiv.hpp"
+
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+#endif
+
+namespace Fp
+{
+namespace detail
+{
+    //! @brief      x / 10 for any 32-bit x (quotient of x * ceil(2^35 / 10) >> 35).
+    inline uint32_t div10_u32(uint32_t x)
+    {
+        uint32_t lo, hi;
+        umul32_wide(x, 0xcccccccdUL, lo, hi);
+        return hi >> 3;
+    }
+
+    //! @brief      x / 10 for any 64-bit x (quotient of x * ceil(2^67 / 10) >> 67).
+    inline uint64_t div10_u64(uint64_t x)
+    {
+        uint64_t lo, hi;
+        umul64_wide(x, 0xcccccccccccccccdULL, lo, hi);
+        return hi >> 3;
+    }
+
+    //! @brief      Decimal digits of x, lowest first, returns the count (1..20).
+    //! @details    The digit is x - 10 * (x / 10), its low byte is enough.
+    inline uint8_t u64_to_digits(uint64_t x, char *rev)
+    {
+        uint8_t n = 0;
+        while (x >> 32) {
+            uint64_t d = div10_u64(x);
+            rev[n++] = (char)('0' + (uint8_t)((uint8_t)x - (uint8_t)d * 10));
+            x = d;
+        }
+        uint32_t x32 = (uint32_t)x;
+        do {
+            uint32_t d = div10_u32(x32);
+            rev[n++] = (char)('0' + (uint8_t)((uint8_t)x32 - (uint8_t)d * 10));
+            x32 = d;
+        } while (x32 != 0);
+        return n;
+    }
+
+    //! @brief      frac = frac * 10 (words lowest first), returns the digit that overflows.
+    inline uint8_t frac_mul10(uint32_t *frac, uint8_t words)
+    {
+        uint32_t carry = 0;
+        for (uint8_t i = 0; i < words; i++) {
+            uint32_t lo = (frac[i] & 0xffffUL) * 10 + carry;
+            uint32_t hi = (frac[i] >> 16) * 10 + (lo >> 16);
+            frac[i] = (hi << 16) | (lo & 0xffffUL);
+            carry = hi >> 16;
+        }
+        return (uint8_t)carry;
+    }
+
+    //! @brief      Writes [-]ipart[.digits] and '\0' to buf, returns the length.
+    //! @details    frac - binary fraction in 32-bit words, lowest first (changed).
+    inline uint8_t fix_to_chars(char *buf, bool neg, uint64_t ipart, uint32_t *frac, uint8_t words, uint8_t digits)
+    {
+        char rev[20];
+        uint8_t pos = 0;
+        if (neg)
+            buf[pos++] = '-';
+        uint8_t n = u64_to_digits(ipart, rev);
+        char *fbuf = buf + pos + n + 1;
+        for (uint8_t i = 0; i < digits; i++)
+            fbuf[i] = (char)('0' + frac_mul10(frac, words));
+        // rest of the fraction >= 1/2: round up
+        if (frac[words - 1] & 0x80000000UL) {
+            uint8_t i = digits;
+            while (i != 0 && fbuf[i - 1] == '9')
+                fbuf[--i] = '0';
+            if (i != 0) {
+                fbuf[i - 1]++;
+            } else {
+                // carry into the integer part, the digits are all '0' now
+                n = u64_to_digits(ipart + 1, rev);
+                fbuf = buf + pos + n + 1;
+                for (i = 0; i < digits; i++)
+                    fbuf[i] = '0';
+            }
+        }
+        while (n != 0)
+            buf[pos++] = rev[--n];
+        if (digits != 0) {
+            buf[pos] = '.';
+            pos += 1 + digits;
+        }
+        buf[pos] = '\0';
+        return pos;
+    }
+
+    //! @brief      Text of raw / 2^q, q = 0..32.
+    inline uint8_t fix32_to_chars(char *buf, int32_t raw, uint8_t q, uint8_t digits)
+    {
+        uint32_t mag = (raw < 0) ? 0 - (uint32_t)raw : (uint32_t)raw;
+        uint32_t frac = (q == 0) ? 0 : mag << (32 - q);
+        return fix_to_chars(buf, raw < 0, (q == 32) ? 0 : mag >> q, &frac, 1, digits);
+    }
+
+    //! @brief      Text of raw / 2^p, p = 0..63.
+    inline uint8_t fix64_to_chars(char *buf, int64_t raw, uint8_t p, uint8_t digits)
+    {
+        uint64_t mag = (raw < 0) ? 0 - (uint64_t)raw : (uint64_t)raw;
+        uint64_t f = (p == 0) ? 0 : mag << (64 - p);
+        uint32_t frac[2] = {(uint32_t)f, (uint32_t)(f >> 32)};
+        return fix_to_chars(buf, raw < 0, mag >> p, frac, 2, digits);
+    }
+
+    //! @brief      ceil(2^(63 + b) / 10^k), k = 1..18, b = bit length of 10^k.
+    inline uint64_t pow10_rcp(uint8_t k)
+    {
+        static const uint64_t tab[18]
+#if defined(__AVR__)
+            PROGMEM
+#endif
+            = {
+            0xcccccccccccccccdULL, 0xa3d70a3d70a3d70bULL, 0x83126e978d4fdf3cULL,
+            0xd1b71758e219652cULL, 0xa7c5ac471b478424ULL, 0x8637bd05af6c69b6ULL,
+            0xd6bf94d5e57a42bdULL, 0xabcc77118461cefdULL, 0x89705f4136b4a598ULL,
+            0xdbe6fecebdedd5bfULL, 0xafebff0bcb24aaffULL, 0x8cbccc096f5088ccULL,
+            0xe12e13424bb40e14ULL, 0xb424dc35095cd810ULL, 0x901d7cf73ab0acdaULL,
+            0xe69594bec44de15cULL, 0xb877aa3236a4b44aULL, 0x9392ee8e921d5d08ULL
+        };
+#if defined(__AVR__)
+        uint64_t m;
+        memcpy_P(&m, &tab[k - 1], sizeof(m));
+        return m;
+#else
+        return tab[k - 1];
+#endif
+    }
+
+    //! @brief      round(f * 2^q / d), f < d = 10^k <= 10^18, q = 0..63.
+    //! @details    The table reciprocal is rounded up, so the estimate of
+    //!             floor(f * 2^(q + 1) / d) is at most 2 too big, the remainder
+    //!             (within +-2 * d, so its low 64 bits are enough) finds the exact one.
+    inline uint64_t frac_from_decimal(uint64_t f, uint64_t d, uint8_t k, uint8_t q)
+    {
+        if (k == 0)
+            return 0;
+        uint8_t b = (uint8_t)(((uint16_t)k * 851) >> 8) + 1;
+        uint8_t s = 62 + b - q;
+        uint64_t lo, hi;
+        umul64_wide(f, pow10_rcp(k), lo, hi);
+        uint64_t n = (s >= 64) ? hi >> (s - 64) : (hi << (64 - s)) | (lo >> s);
+        umul64_wide(n, d, lo, hi);
+        int64_t r = (int64_t)(((q == 63) ? 0 : f << (q + 1)) - lo);
+        while (r < 0) {
+            r += (int64_t)d;
+            n--;
+        }
+        // n = floor(2x), round(x) = (floor(2x) + 1) / 2
+        return (n >> 1) + (n & 1);
+    }
+
+    //! @brief      Reads [+|-]digits[.digits] as round(|x| * 2^q), returns the
+    //!             number of characters used (0 - no number at the start of s).
+    //! @details    An integer part of 2^64 / 10 or more sets over. Fraction digits
+    //!             after the 18th are read but ignored, that can only change the
+    //!             result for q > 17 (ties between two results have q + 1 decimals).
+    inline uint8_t chars_to_fix(const char *s, uint8_t len, uint8_t q, bool &neg, uint64_t &ipart, uint64_t &frac, bool &over)
+    {
+        uint8_t pos = 0;
+        uint8_t n = 0;
+        neg = false;
+        over = false;
+        ipart = 0;
+        frac = 0;
+        if (pos < len && (s[pos] == '-' || s[pos] == '+'))
+            neg = (s[pos++] == '-');
+        for (; pos < len && (uint8_t)(s[pos] - '0') <= 9; pos++, n++) {
+            if (ipart >= 0x1999999999999999ULL)
+                over = true;
+            ipart = ipart * 10 + (uint8_t)(s[pos] - '0');
+        }
+        uint64_t f = 0;
+        uint64_t d = 1;
+        uint8_t k = 0;
+        if (pos < len && s[pos] == '.') {
+            uint8_t m = 0;
+            for (pos++; pos + m < len && (uint8_t)(s[pos + m] - '0') <= 9; m++) {
+                if (k < 18) {
+                    f = f * 10 + (uint8_t)(s[pos + m] - '0');
+                    d *= 10;
+                    k++;
+                }
+            }
+            // a lone '.' is not part of the number
+            if (m == 0 && n == 0)
+                pos--;
+            pos += m;
+            n += m;
+        }
+        if (n == 0)
+            return 0;
+        frac = frac_from_decimal(f, d, k, q);
+        return pos;
+    }
+
+    //! @brief      Parses text to raw / 2^q, q = 0..32, saturates, returns the length used.
+    inline uint8_t chars_to_fix32(const char *s, uint8_t len, uint8_t q, int32_t &raw)
+    {
+        bool neg, over;
+        uint64_t ipart, frac;
+        uint8_t pos = chars_to_fix(s, len, q, neg, ipart, frac, over);
+        raw = 0;
+        if (pos == 0)
+            return 0;
+        uint64_t mag = 0x80000000ULL;
+        if (!over && ipart <= 0x80000000ULL)
+            mag = (ipart << q) + frac;
+        uint64_t lim = neg ? 0x80000000ULL : 0x7fffffffULL;
+        if (mag > lim)
+            mag = lim;
+        raw = neg ? (int32_t)(0 - (uint32_t)mag) : (int32_t)mag;
+        return pos;
+    }
+
+    //! @brief      Parses text to raw / 2^p, p = 0..63, saturates, returns the length used.
+    inline uint8_t chars_to_fix64(const char *s, uint8_t len, uint8_t p, int64_t &raw)
+    {
+        bool neg, over;
+        uint64_t ipart, frac;
+        uint8_t pos = chars_to_fix(s, len, p, neg, ipart, frac, over);
+        raw = 0;
+        if (pos == 0)
+            return 0;
+        uint64_t mag = 0x8000000000000000ULL;
+        if (!over && (p == 0 || (ipart >> (64 - p)) == 0)) {
+            uint64_t i = ipart << p;
+            if (i + frac >= i)
+                mag = i + frac;
+        }
+        uint64_t lim = neg ? 0x8000000000000000ULL : 0x7fffffffffffffffULL;
+        if (mag > lim)
+            mag = lim;
+        raw = neg ? (int64_t)(0 - mag) : (int64_t)mag;
+        return pos;
+    }
+} // namespace detail
+} // namespace Fp
+
+#endif // #ifndef FP_CHARS_H
+// EOF
@@ -0,0 +1,197 @@
+//!
+//! @file               FpDiv.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              Fixed-point division by a Newton-Raphson reciprocal, no 64-bit divide.
+//! @details
+//!     (a << q) / b is lowered to a 64-bit division (__divdi3), a bit by bit loop
+//!     and the slowest operation on AVR. Here the divisor is normalised, its
+//!     reciprocal is refined by Newton-Raphson x = x + x * (1 - d * x) from a 16-entry
+//!     seed (4 bits) and the quotient is a multiplication, see DivMode for the
+//!     accuracy levels. All multiplications go through umul32_wide() (FpMul.hpp).
+//!
+//!     Error of the quotient, in ULP of the result (the result is never above the
+//!     exact truncated quotient, |Q| - the exact quotient):
+//!
+//!     mode          iterations    32-bit: bits, max ULP    64-bit: bits, max ULP
+//!     DIV_NR1       1             8,  |Q| / 2^8 + 1        8,  |Q| / 2^8 + 1
+//!     DIV_NR2       2             16, |Q| / 2^16 + 1       16, |Q| / 2^16 + 1
+//!     DIV_NR3       3             30, 5                    32, |Q| / 2^32 + 1
+//!     DIV_EXACT     3 (4) + fix   exact                    exact
+//!
+//!     Over random operands the 32-bit DIV_NR3 error was at most 4 ULP. Exact means the
+//!     same result as the integer division (a << q) / b for every result which fits
+//!     the type. A 32-bit quotient outside int32_t saturates to INT32_MAX / INT32_MIN,
+//!     so does division by zero.
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef FP_DIV_H
+#define FP_DIV_H
+
+#include <stdint.h>
+#include "FpMul.hpp"
+
+namespace Fp
+{
+    //! @brief      Accuracy level of the reciprocal division, see the table above.
+    enum DivMode {
+        DIV_NR1 = 1,
+        DIV_NR2 = 2,
+        DIV_NR3 = 3,
+        DIV_EXACT = 4
+    };
+
+//! @brief      Accuracy of the division operators (operator /=), define it before
+//!             the first include to change it.
+#ifndef FP_DIV_MODE
+    #define FP_DIV_MODE Fp::DIV_EXACT
+#endif
+
+namespace detail
+{
+    //! @brief      Seed of the reciprocal for the normalised divisor d in [1/2, 1):
+    //!             1 + rcp_seed(i) / 256 <= 1 / d, i = the 4 bits after the leading one.
+    //! @details    Taken at the upper end of each interval, so the seed and every
+    //!             Newton step stay below 1 / d (relative error < 1/17).
+    inline uint16_t rcp_seed(uint8_t i)
+    {
+        // floor(256 * 32 / (17 + i)) - 256
+        static const uint8_t tab[16] = {
+            225, 199, 175, 153, 134, 116, 100, 85, 71, 59, 47, 36, 26, 17, 8, 0
+        };
+        return 256 + tab[i];
+    }
+
+    //! @brief      x <= 2^63 / dn, dn normalised (top bit set).
+    inline uint32_t recip32(uint32_t dn, uint8_t iterations)
+    {
+        uint32_t x = (uint32_t)rcp_seed((uint8_t)(dn >> 27) & 15) << 23;
+        for (; iterations != 0; iterations--) {
+            uint32_t lo, hi;
+            umul32_wide(dn, x, lo, hi);
+            // top 32 bits of e = 2^63 - dn * x >= 0
+            uint32_t e = 0x80000000UL - hi - (lo != 0 ? 1 : 0);
+            // x += (x * e) >> 31
+            umul32_wide(x, e, lo, hi);
+            x += (hi << 1) | (lo >> 31);
+        }
+        return x;
+    }
+
+    //! @brief      floor(n / d), n = nh * 2^32 + nl, the quotient must fit 32 bits (nh < d).
+    inline uint32_t udiv64_32(uint32_t nh, uint32_t nl, uint32_t d, uint8_t mode)
+    {
+        uint8_t s = clz32(d);
+        uint32_t x = recip32(d << s, mode == DIV_EXACT ? 3 : mode);
+        // q = (n * x) >> (63 - s), only bits 32..95 of the product are needed
+        uint32_t l_lo, l_hi, h_lo, h_hi;
+        umul32_wide(nl, x, l_lo, l_hi);
+        umul32_wide(nh, x, h_lo, h_hi);
+        uint32_t p1 = l_hi + h_lo;
+        uint32_t p2 = h_hi + (p1 < h_lo ? 1 : 0);
+        uint32_t q = (p1 >> (31 - s)) | ((p2 << 1) << s);
+        if (mode == DIV_EXACT) {
+            // q is a few units below the quotient, fix it by the remainder
+            uint32_t m_lo, m_hi;
+            umul32_wide(q, d, m_lo, m_hi);
+            uint64_t r = (((uint64_t)nh << 32) | nl) - (((uint64_t)m_hi << 32) | m_lo);
+            while (r >= d) {
+                r -= d;
+                q++;
+            }
+        }
+        return q;
+    }
+
+    //! @brief      ((int64_t)a << q) / b for q = 0..32, rounded toward zero and
+    //!             saturated to the int32_t range.
+    inline int32_t div32_shl(int32_t a, int32_t b, uint8_t q, uint8_t mode)
+    {
+        bool neg = (a < 0) != (b < 0);
+        uint32_t ua = (a < 0) ? 0 - (uint32_t)a : (uint32_t)a;
+        uint32_t ub = (b < 0) ? 0 - (uint32_t)b : (uint32_t)b;
+        uint32_t nh = (q == 0) ? 0 : ua >> (32 - q);
+        uint32_t nl = (q == 32) ? 0 : ua << q;
+        // quotient above 32 bits (and b == 0)
+        if (nh >= ub) {
+            return neg ? (int32_t)0x80000000UL : (int32_t)0x7fffffffUL;
+        }
+        uint32_t r = udiv64_32(nh, nl, ub, mode);
+        // 32 bits, but not always an int32_t: 2^31 is the limit of the negative side
+        if (neg) {
+            return (r >= 0x80000000UL) ? (int32_t)0x80000000UL : (int32_t)(0 - r);
+        }
+        return (r > 0x7fffffffUL) ? (int32_t)0x7fffffffUL : (int32_t)r;
+    }
+
+    //! @brief      Unsigned 64x64->128 product from four 32x32->64 products.
+    inline void umul64_wide(uint64_t a, uint64_t b, uint64_t &lo, uint64_t &hi)
+    {
+        uint32_t ll_lo, ll_hi, lh_lo, lh_hi, hl_lo, hl_hi, hh_lo, hh_hi;
+        umul32_wide((uint32_t)a, (uint32_t)b, ll_lo, ll_hi);
+        umul32_wide((uint32_t)a, (uint32_t)(b >> 32), lh_lo, lh_hi);
+        umul32_wide((uint32_t)(a >> 32), (uint32_t)b, hl_lo, hl_hi);
+        umul32_wide((uint32_t)(a >> 32), (uint32_t)(b >> 32), hh_lo, hh_hi);
+        // middle column, up to 34 bits
+        uint64_t mid = (uint64_t)ll_hi + lh_lo + hl_lo;
+        lo = (mid << 32) | ll_lo;
+        hi = (((uint64_t)hh_hi << 32) | hh_lo) + lh_hi + hl_hi + (mid >> 32);
+    }
+
+    //! @brief      x <= 2^127 / dn, dn normalised (top bit set).
+    inline uint64_t recip64(uint64_t dn, uint8_t iterations)
+    {
+        uint64_t x = (uint64_t)rcp_seed((uint8_t)(dn >> 59) & 15) << 55;
+        for (; iterations != 0; iterations--) {
+            uint64_t lo, hi;
+            umul64_wide(dn, x, lo, hi);
+            // top 64 bits of e = 2^127 - dn * x >= 0
+            uint64_t e = 0x8000000000000000ULL - hi - (lo != 0 ? 1 : 0);
+            // x += (x * e) >> 63
+            umul64_wide(x, e, lo, hi);
+            x += (hi << 1) | (lo >> 63);
+        }
+        return x;
+    }
+
+    //! @brief      floor(n / d), d must not be 0.
+    inline uint64_t udiv64(uint64_t n, uint64_t d, uint8_t mode)
+    {
+        uint8_t s = (d >> 32) ? clz32((uint32_t)(d >> 32)) : 32 + clz32((uint32_t)d);
+        uint64_t x = recip64(d << s, mode == DIV_EXACT ? 4 : mode);
+        // q = (n * x) >> (127 - s)
+        uint64_t lo, hi;
+        umul64_wide(n, x, lo, hi);
+        uint64_t q = hi >> (63 - s);
+        if (mode == DIV_EXACT) {
+            // the remainder never exceeds n, so 64 bits are enough
+            umul64_wide(q, d, lo, hi);
+            uint64_t r = n - lo;
+            while (r >= d) {
+                r -= d;
+                q++;
+            }
+        }
+        return q;
+    }
+
+    //! @brief      (a << p) / b rounded toward zero, a << p must fit int64_t.
+    inline int64_t div64_shl(int64_t a, int64_t b, uint8_t p, uint8_t mode)
+    {
+        bool neg = (a < 0) != (b < 0);
+        uint64_t ua = (a < 0) ? 0 - (uint64_t)a : (uint64_t)a;
+        uint64_t ub = (b < 0) ? 0 - (uint64_t)b : (uint64_t)b;
+        if (ub == 0) {
+            return neg ? (int64_t)0x8000000000000000ULL : (int64_t)0x7fffffffffffffffULL;
+        }
+        uint64_t r = udiv64(ua << p, ub, mode);
+        return neg ? (int64_t)(0 - r) : (int64_t)r;
+    }
+} // namespace detail
+} // namespace Fp
+
+#endif // #ifndef FP_DIV_H
+// EOF
@@ -0,0 +1,190 @@
+//!
+//! @file               FpFloat.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              Fixed-point <-> float conversions done on the IEEE-754 bits.
+//! @details
+//!     (float)rawVal / (float)(1 << q) costs a soft-float conversion and divide on AVR.
+//!     The value is rawVal * 2^-q, so the float is: sign, exponent 127 + (bit length
+//!     of |rawVal|) - 1 - q and the 24 top bits of |rawVal| as mantissa, rounded to
+//!     nearest even like the int to float conversion. The division by a power of two
+//!     is exact (no subnormals for q <= 32), so the result is bit-identical to the
+//!     C++ expression for every input.
+//!     From float, the 24-bit mantissa is shifted by the unbiased exponent - 23 + q
+//!     instead of the soft-float multiply by 2^q. The result is rounded as asked
+//!     (truncation is the same as the C++ cast of f * 2^q) and saturated to the
+//!     int32_t range, NaN gives 0.
+//!     Used on AVR (or with FP_FLOAT_BITS defined), define FP_FLOAT_NO_BITS to keep
+//!     the C++ expression.
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef FP_FLOAT_H
+#define FP_FLOAT_H
+
+#include <stdint.h>
+#include "FpMul.hpp"    // normalize32()
+
+#if (defined(__AVR__) || defined(FP_FLOAT_BITS)) && !defined(FP_FLOAT_NO_BITS)
+    #define FP_FLOAT_USE_BITS 1
+#else
+    #define FP_FLOAT_USE_BITS 0
+#endif
+
+namespace Fp
+{
+    //! @brief      Rounding of float to fixed-point conversion.
+    enum FloatRound {
+        ROUND_TRUNC = 0,    // toward zero, as the (int32_t) cast
+        ROUND_NEAREST = 1   // to nearest, half away from zero
+    };
+
+namespace detail
+{
+    inline float float_from_bits(uint32_t bits)
+    {
+        union {
+            uint32_t u;
+            float f;
+        } x;
+        x.u = bits;
+        return x.f;
+    }
+
+    inline uint32_t float_to_bits(float f)
+    {
+        union {
+            float f;
+            uint32_t u;
+        } x;
+        x.f = f;
+        return x.u;
+    }
+
+    //! @brief      x >> n for n = 0..31, whole bytes first (register moves on AVR).
+    inline uint32_t shr32(uint32_t x, uint8_t n)
+    {
+        if (n & 16) x >>= 16;
+        if (n & 8) x >>= 8;
+        for (n &= 7; n != 0; n--)
+            x >>= 1;
+        return x;
+    }
+
+    //! @brief      (float)raw / (float)(1 << q), q = 0..32, built bit by bit.
+    inline float fix32_to_float_bits(int32_t raw, uint8_t q)
+    {
+        if (raw == 0)
+            return 0.0f;
+        uint32_t sign = (raw < 0) ? 0x80000000UL : 0;
+        uint32_t m = (raw < 0) ? 0 - (uint32_t)raw : (uint32_t)raw;
+        // leading one to bit 31, so the value is m * 2^(31 - n - q)
+        uint8_t n = normalize32(m);
+        uint32_t exp = 127 + 31 - n - q;
+        uint32_t mant = m >> 8;
+        uint8_t rest = (uint8_t)m;
+        // round to nearest, ties to even
+        if (rest > 0x80 || (rest == 0x80 && (mant & 1))) {
+            mant++;
+            if (mant == 0x1000000UL) {
+                mant >>= 1;
+                exp++;
+            }
+        }
+        return float_from_bits(sign | (exp << 23) | (mant & 0x7fffffUL));
+    }
+
+    //! @brief      f * 2^q, q = 0..32, rounded and saturated to int32_t, built bit by bit.
+    inline int32_t float_to_fix32_bits(float f, uint8_t q, uint8_t round)
+    {
+        uint32_t bits = float_to_bits(f);
+        bool neg = (bits >> 31) != 0;
+        uint8_t e = (uint8_t)(bits >> 23);
+        int32_t sat = neg ? (int32_t)0x80000000UL : (int32_t)0x7fffffffUL;
+        if (e == 0xff)
+            return (bits & 0x7fffffUL) ? 0 : sat;   // NaN, infinity
+        if (e == 0)
+            return 0;                               // zero, subnormal
+        uint32_t m = (bits & 0x7fffffUL) | 0x800000UL;
+        // f * 2^q = m * 2^s
+        int16_t s = (int16_t)e - 150 + q;
+        uint32_t mag;
+        if (s > 8) {
+            return sat;
+        } else if (s >= 0) {
+            mag = m << s;
+        } else if (s < -24) {
+            return 0;
+        } else {
+            // keep one more bit for the rounding
+            mag = shr32(m, (uint8_t)(-s - 1));
+            uint8_t half = (uint8_t)mag & 1;
+            mag >>= 1;
+            if (round == ROUND_NEAREST)
+                mag += half;
+        }
+        if (mag > (neg ? 0x80000000UL : 0x7fffffffUL))
+            return sat;
+        return neg ? (int32_t)(0 - mag) : (int32_t)mag;
+    }
+
+    //! @brief      Fixed-point to float for the conversion operators, constant
+    //!             operands are folded by the compiler (and keep constexpr working).
+#if FP_FLOAT_USE_BITS
+    constexpr float fix32_to_float(int32_t raw, uint8_t q)
+    {
+        return (__builtin_constant_p(raw) && __builtin_constant_p(q)) ?
+            (float)raw / (float)((uint64_t)1 << q) : fix32_to_float_bits(raw, q);
+    }
+#else
+    constexpr float fix32_to_float(int32_t raw, uint8_t q)
+    {
+        return (float)raw / (float)((uint64_t)1 << q);
+    }
+#endif
+
+    //! @brief      Fixed-point to double, the float path where double is float (AVR).
+#if FP_FLOAT_USE_BITS && (__SIZEOF_DOUBLE__ == 4)
+    constexpr double fix32_to_double(int32_t raw, uint8_t q)
+    {
+        return fix32_to_float(raw, q);
+    }
+#else
+    constexpr double fix32_to_double(int32_t raw, uint8_t q)
+    {
+        return (double)raw / (double)((uint64_t)1 << q);
+    }
+#endif
+
+    //! @brief      Float to fixed-point for the constructors, rounded toward zero.
+#if FP_FLOAT_USE_BITS
+    constexpr int32_t float_to_fix32(float f, uint8_t q)
+    {
+        return (__builtin_constant_p(f) && __builtin_constant_p(q)) ?
+            (int32_t)(f * (float)((uint64_t)1 << q)) : float_to_fix32_bits(f, q, ROUND_TRUNC);
+    }
+#else
+    constexpr int32_t float_to_fix32(float f, uint8_t q)
+    {
+        return (int32_t)(f * (float)((uint64_t)1 << q));
+    }
+#endif
+
+#if FP_FLOAT_USE_BITS && (__SIZEOF_DOUBLE__ == 4)
+    constexpr int32_t double_to_fix32(double f, uint8_t q)
+    {
+        return float_to_fix32(f, q);
+    }
+#else
+    constexpr int32_t double_to_fix32(double f, uint8_t q)
+    {
+        return (int32_t)(f * (double)((uint64_t)1 << q));
+    }
+#endif
+} // namespace detail
+} // namespace Fp
+
+#endif // #ifndef FP_FLOAT_H
+// EOF
@@ -0,0 +1,136 @@
+//!
+//! @file               FpLiteral.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              Compile-time parser of decimal literals into raw fixed-point values.
+//! @details
+//!     Used by the user-defined literals of the fixed-point classes (e.g. 0.01_q7).
+//!     The literal text is parsed by the compiler with integer arithmetic only
+//!     (no float, so no soft-float code) and rounded to nearest in the chosen Q.
+//!     A literal which does not fit the Q, or rounds to zero, fails the build.
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef FP_LITERAL_H
+#define FP_LITERAL_H
+
+#include <stdint.h>
+
+namespace Fp
+{
+namespace detail
+{
+    // literal characters as a string usable in constant expressions
+    template <char... c>
+    struct LiteralChars {
+        static constexpr char str[sizeof...(c) + 1] = {c..., '\0'};
+    };
+    template <char... c>
+    constexpr char LiteralChars<c...>::str[sizeof...(c) + 1];
+
+    constexpr bool lit_is_digit(char ch)
+    {
+        return ch >= '0' && ch <= '9';
+    }
+
+    constexpr bool lit_is_exp(char ch)
+    {
+        return ch == 'e' || ch == 'E';
+    }
+
+    // 0x.., 0b.. and octal literals are not decimal
+    constexpr bool lit_has_prefix(const char *s)
+    {
+        return s[0] == '0' && s[1] != '\0' && s[1] != '.' && !lit_is_exp(s[1]);
+    }
+
+    // digits of the mantissa (before the exponent), '.' and digit separators skipped
+    constexpr uint8_t lit_digit_count(const char *s, uint8_t n = 0)
+    {
+        return (*s == '\0' || lit_is_exp(*s)) ? n :
+            lit_digit_count(s + 1, lit_is_digit(*s) ? n + 1 : n);
+    }
+
+    constexpr uint64_t lit_mantissa(const char *s, uint64_t m = 0)
+    {
+        return (*s == '\0' || lit_is_exp(*s)) ? m :
+            lit_mantissa(s + 1, lit_is_digit(*s) ? m * 10 + (uint64_t)(*s - '0') : m);
+    }
+
+    constexpr int16_t lit_frac_digits(const char *s, bool after_dot = false, int16_t n = 0)
+    {
+        return (*s == '\0' || lit_is_exp(*s)) ? n :
+            lit_frac_digits(s + 1, after_dot || *s == '.', (after_dot && lit_is_digit(*s)) ? n + 1 : n);
+    }
+
+    constexpr int16_t lit_exp_digits(const char *s, int16_t e = 0)
+    {
+        return (*s == '\0' || e > 999) ? e : lit_exp_digits(s + 1, e * 10 + (*s - '0'));
+    }
+
+    // value of the e+NN/e-NN part, 0 if there is none
+    constexpr int16_t lit_exponent(const char *s)
+    {
+        return (*s == '\0') ? 0 :
+            !lit_is_exp(*s) ? lit_exponent(s + 1) :
+            (s[1] == '-') ? -lit_exp_digits(s + 2) :
+            (s[1] == '+') ? lit_exp_digits(s + 2) : lit_exp_digits(s + 1);
+    }
+
+    // literal value is mantissa * 10^exp10
+    constexpr int16_t lit_exp10(const char *s)
+    {
+        return lit_exponent(s) - lit_frac_digits(s);
+    }
+
+    constexpr uint64_t lit_pow10(int16_t n)
+    {
+        return (n <= 0) ? 1 : 10 * lit_pow10(n - 1);
+    }
+
+    // m * 10^n, or max + 1 if it is above max
+    constexpr uint64_t lit_scale10(uint64_t m, int16_t n, uint64_t max)
+    {
+        return (m == 0 || n <= 0) ? ((m > max) ? max + 1 : m) :
+            (m > max / 10) ? max + 1 : lit_scale10(m * 10, n - 1, max);
+    }
+
+    // round(r * 2^bits / d) for r < d <= 10^18, by bit by bit long division
+    constexpr uint64_t lit_frac_bits(uint64_t r, uint64_t d, uint8_t bits, uint64_t f = 0)
+    {
+        return (bits == 0) ? f + ((2 * r >= d) ? 1 : 0) :
+            (2 * r >= d) ? lit_frac_bits(2 * r - d, d, bits - 1, (f << 1) | 1) :
+                           lit_frac_bits(2 * r, d, bits - 1, f << 1);
+    }
+
+    //! @brief      Decimal literal (characters c) converted to raw value with q fractional bits.
+    //! @details    raw is the rounded value if it fits max_raw, otherwise the build fails.
+    template <uint8_t q, uint64_t max_raw, char... c>
+    struct FixedLiteral {
+        static constexpr const char *str = LiteralChars<c...>::str;
+        static constexpr uint64_t mantissa = lit_mantissa(str);
+        static constexpr int16_t exp10 = lit_exp10(str);
+
+        static_assert(!lit_has_prefix(str), "fixed-point literal: only decimal numbers are supported");
+        static_assert(lit_digit_count(str) <= 19, "fixed-point literal: too many digits");
+        static_assert(exp10 >= -18 || mantissa == 0, "fixed-point literal: too many fractional digits");
+
+        // integer part and the remainder of the fractional digits
+        static constexpr uint64_t divisor = lit_pow10((exp10 < -18) ? 18 : -exp10);
+        static constexpr uint64_t ipart = lit_scale10(mantissa / divisor, exp10, max_raw >> q);
+        static constexpr uint64_t frac = lit_frac_bits(mantissa % divisor, divisor, q);
+
+        static_assert(ipart <= (max_raw >> q) && (ipart << q) + frac <= max_raw,
+            "fixed-point literal: value does not fit the chosen Q");
+        static_assert(mantissa == 0 || (ipart << q) + frac != 0,
+            "fixed-point literal: value rounds to zero in the chosen Q");
+
+        static constexpr uint64_t raw = (ipart << q) + frac;
+    };
+} // namespace detail
+} // namespace Fp
+
+#endif // #ifndef FP_LITERAL_H
+// EOF
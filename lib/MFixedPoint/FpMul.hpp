@@ -0,0 +1,199 @@
+//!
+//! @file               FpMul.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              32x32->64 widening multiplication kernel for the fixed-point multiply.
+//! @details
+//!     (int32_t)(((int64_t)a * b) >> q) is lowered by avr-gcc to a 64x64 multiply
+//!     (__muldi3) and a 64-bit shift loop (__ashrdi3). On AVR the product is built
+//!     here from 16 8x8 'mul' instructions and the shift is done byte-wise, on
+//!     other targets the plain C++ expression is used.
+//!     Define FP_MUL_NO_ASM to use the C++ code on AVR as well.
+//!     The bit scan normalize32() / clz32() shared by the division and the float
+//!     conversion lives here too, so neither has to include the other.
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef FP_MUL_H
+#define FP_MUL_H
+
+#include <stdint.h>
+
+namespace Fp
+{
+namespace detail
+{
+    //! @brief      Shifts x left until the top bit is set, returns the shift, x must not be 0.
+    inline uint8_t normalize32(uint32_t &x)
+    {
+        uint8_t n = 0;
+        if (!(x & 0xffff0000UL)) { n += 16; x <<= 16; }
+        if (!(x & 0xff000000UL)) { n += 8;  x <<= 8; }
+        if (!(x & 0xf0000000UL)) { n += 4;  x <<= 4; }
+        if (!(x & 0xc0000000UL)) { n += 2;  x <<= 2; }
+        if (!(x & 0x80000000UL)) { n += 1;  x <<= 1; }
+        return n;
+    }
+
+    //! @brief      Number of leading zero bits, x must not be 0.
+    inline uint8_t clz32(uint32_t x)
+    {
+        return normalize32(x);
+    }
+
+    //! @brief      Unsigned 32x32->64 product, lo - bits 0..31, hi - bits 32..63.
+    inline void umul32_wide(uint32_t a, uint32_t b, uint32_t &lo, uint32_t &hi)
+    {
+#if defined(__AVR__) && !defined(FP_MUL_NO_ASM)
+        uint8_t zero;
+        // diagonal products a_i*b_i fill the result without additions, the 12
+        // cross products are added column by column with the carry rippled up
+        asm (
+            "mul  %A[a], %A[b]"  "\n\t"
+            "movw %A[lo], r0"    "\n\t"
+            "mul  %B[a], %B[b]"  "\n\t"
+            "movw %C[lo], r0"    "\n\t"
+            "mul  %C[a], %C[b]"  "\n\t"
+            "movw %A[hi], r0"    "\n\t"
+            "mul  %D[a], %D[b]"  "\n\t"
+            "movw %C[hi], r0"    "\n\t"
+            "clr  %[z]"          "\n\t"
+            // column 1
+            "mul  %A[a], %B[b]"  "\n\t"
+            "add  %B[lo], r0"    "\n\t"
+            "adc  %C[lo], r1"    "\n\t"
+            "adc  %D[lo], %[z]"  "\n\t"
+            "adc  %A[hi], %[z]"  "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %B[a], %A[b]"  "\n\t"
+            "add  %B[lo], r0"    "\n\t"
+            "adc  %C[lo], r1"    "\n\t"
+            "adc  %D[lo], %[z]"  "\n\t"
+            "adc  %A[hi], %[z]"  "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            // column 2
+            "mul  %A[a], %C[b]"  "\n\t"
+            "add  %C[lo], r0"    "\n\t"
+            "adc  %D[lo], r1"    "\n\t"
+            "adc  %A[hi], %[z]"  "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %C[a], %A[b]"  "\n\t"
+            "add  %C[lo], r0"    "\n\t"
+            "adc  %D[lo], r1"    "\n\t"
+            "adc  %A[hi], %[z]"  "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            // column 3
+            "mul  %A[a], %D[b]"  "\n\t"
+            "add  %D[lo], r0"    "\n\t"
+            "adc  %A[hi], r1"    "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %D[a], %A[b]"  "\n\t"
+            "add  %D[lo], r0"    "\n\t"
+            "adc  %A[hi], r1"    "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %B[a], %C[b]"  "\n\t"
+            "add  %D[lo], r0"    "\n\t"
+            "adc  %A[hi], r1"    "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %C[a], %B[b]"  "\n\t"
+            "add  %D[lo], r0"    "\n\t"
+            "adc  %A[hi], r1"    "\n\t"
+            "adc  %B[hi], %[z]"  "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            // column 4
+            "mul  %B[a], %D[b]"  "\n\t"
+            "add  %A[hi], r0"    "\n\t"
+            "adc  %B[hi], r1"    "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %D[a], %B[b]"  "\n\t"
+            "add  %A[hi], r0"    "\n\t"
+            "adc  %B[hi], r1"    "\n\t"
+            "adc  %C[hi], %[z]"  "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            // column 5
+            "mul  %C[a], %D[b]"  "\n\t"
+            "add  %B[hi], r0"    "\n\t"
+            "adc  %C[hi], r1"    "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "mul  %D[a], %C[b]"  "\n\t"
+            "add  %B[hi], r0"    "\n\t"
+            "adc  %C[hi], r1"    "\n\t"
+            "adc  %D[hi], %[z]"  "\n\t"
+            "clr  __zero_reg__"
+            : [lo] "=&r" (lo), [hi] "=&r" (hi), [z] "=&r" (zero)
+            : [a] "r" (a), [b] "r" (b)
+        );
+#else
+        uint64_t p = (uint64_t)a * b;
+        lo = (uint32_t)p;
+        hi = (uint32_t)(p >> 32);
+#endif
+    }
+
+    //! @brief      (int32_t)(((int64_t)a * b) >> q) for q = 0..32 without 64-bit library calls.
+    //! @details    Only bits q..q+31 of the product are kept, so the shift is done
+    //!             on the two 32-bit halves: whole bytes first (register moves), then
+    //!             at most 7 single bit steps. With a constant q it folds to moves only.
+    inline int32_t mul32_shr_wide(int32_t a, int32_t b, uint8_t q)
+    {
+        uint32_t lo, hi;
+        umul32_wide((uint32_t)a, (uint32_t)b, lo, hi);
+        // signed product from the unsigned one
+        if (a < 0) hi -= (uint32_t)b;
+        if (b < 0) hi -= (uint32_t)a;
+        if (q & 32) {
+            lo = hi;
+        }
+        if (q & 16) {
+            lo = (lo >> 16) | (hi << 16);
+            hi >>= 16;
+        }
+        if (q & 8) {
+            lo = (lo >> 8) | (hi << 24);
+            hi >>= 8;
+        }
+        for (uint8_t i = q & 7; i != 0; i--) {
+            lo = (lo >> 1) | (hi << 31);
+            hi >>= 1;
+        }
+        return (int32_t)lo;
+    }
+
+    //! @brief      Fixed-point multiplication kernel: (int32_t)(((int64_t)a * b) >> q).
+#if defined(__AVR__) && !defined(FP_MUL_NO_ASM)
+    // constant operands are folded by the compiler (and keep constexpr working),
+    // the rest goes to the mul kernel
+    constexpr int32_t mul32_shr(int32_t a, int32_t b, uint8_t q)
+    {
+        return (__builtin_constant_p(a) && __builtin_constant_p(b) && __builtin_constant_p(q)) ?
+            (int32_t)(((int64_t)a * b) >> q) : mul32_shr_wide(a, b, q);
+    }
+#else
+    constexpr int32_t mul32_shr(int32_t a, int32_t b, uint8_t q)
+    {
+        return (int32_t)(((int64_t)a * b) >> q);
+    }
+#endif
+} // namespace detail
+} // namespace Fp
+
+#endif // #ifndef FP_MUL_H
+// EOF
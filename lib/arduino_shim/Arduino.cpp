@@ -0,0 +1,200 @@
+// Arduino API subset for running the sketch on the host
+// AndrewBiz
+
+#include <Arduino.h>
+#include <time.h>
+#include <cmath> // not <math.h>: that is the sketch in src
+
+HardwareSerial Serial;
+
+#ifdef UNIT_TEST
+static uint64_t test_us = 0;
+
+void shim_set_micros(uint32_t us) {
+  test_us = us;
+}
+
+static uint64_t clock_us(void) {
+  return test_us;
+}
+#else
+static uint64_t clock_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+#endif
+
+static const uint64_t start_us = clock_us();
+
+unsigned long millis(void) {
+  return (unsigned long)(uint32_t)((clock_us() - start_us) / 1000);
+}
+
+unsigned long micros(void) {
+  return (unsigned long)(uint32_t)(clock_us() - start_us);
+}
+
+void delay(unsigned long ms) {
+  struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000L};
+  nanosleep(&ts, 0);
+}
+
+void delayMicroseconds(unsigned int us) {
+  struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000L};
+  nanosleep(&ts, 0);
+}
+
+char *dtostrf(double val, signed char width, unsigned char prec, char *s) {
+  float f = (float)val;
+  char txt[24];
+  uint8_t len = 0;
+  if (std::isnan(f)) {
+    strcpy(txt, "nan");
+    len = 3;
+  } else if (std::isinf(f)) {
+    len = (uint8_t)sprintf(txt, "%sinf", f < 0 ? "-" : "");
+  } else {
+    // the exact decimal value of the float (at most 112 significant digits),
+    // rounded half up to the last printed decimal, but to no more than 8 digits
+    char e[128];
+    float a = std::fabs(f);
+    sprintf(e, "%.112e", a);
+    int exp10 = atoi(strchr(e, 'e') + 1);
+    int ndigs = exp10 + 1 + prec;
+    if (ndigs > 8) ndigs = 8;
+    char digs[9];
+    uint8_t n = 0;
+    if (ndigs < 1) {
+      // below the last decimal: 0 or one unit of it
+      if (ndigs == 0 && e[0] >= '5') {
+        digs[n++] = '1';
+        exp10 = -prec;
+      }
+    } else {
+      for (const char *p = e; n < ndigs; p++)
+        if (*p != '.') digs[n++] = *p;
+    }
+    if (ndigs >= 1 && e[ndigs + 1] >= '5') {
+      int i = n;
+      while (i != 0 && digs[i - 1] == '9') digs[--i] = '0';
+      if (i != 0) {
+        digs[i - 1]++;
+      } else {
+        digs[0] = '1';
+        exp10++;
+      }
+    }
+    if (std::signbit(f) && a != 0) txt[len++] = '-';
+    for (int k = (exp10 < 0) ? 0 : exp10; k >= 0; k--) {
+      int i = exp10 - k;
+      txt[len++] = (i >= 0 && i < n) ? digs[i] : '0';
+    }
+    if (prec != 0) txt[len++] = '.';
+    for (int k = 1; k <= prec && len < sizeof(txt) - 1; k++) {
+      int i = exp10 + k;
+      txt[len++] = (i >= 0 && i < n) ? digs[i] : '0';
+    }
+    txt[len] = 0;
+  }
+  uint8_t w = (uint8_t)((width < 0) ? -width : width);
+  uint8_t pad = (w > len) ? w - len : 0;
+  char *p = s;
+  if (width > 0)
+    for (; pad != 0; pad--) *p++ = ' ';
+  memcpy(p, txt, len);
+  p += len;
+  for (; pad != 0; pad--) *p++ = ' ';
+  *p = 0;
+  return s;
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(long n, int base) {
+  int32_t v = (int32_t)n;
+  if (base == 0) return write((uint8_t)v);
+  if (base == 10 && v < 0) {
+    size_t t = print('-');
+    return t + printNumber(0 - (uint32_t)v, 10);
+  }
+  return printNumber((uint32_t)v, (uint8_t)base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  if (base == 0) return write((uint8_t)n);
+  return printNumber((uint32_t)n, (uint8_t)base);
+}
+
+size_t Print::printNumber(uint32_t n, uint8_t base) {
+  char buf[33];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = (char)(n % base);
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+// the core's algorithm, in float like on AVR
+size_t Print::printFloat(float number, uint8_t digits) {
+  size_t n = 0;
+  if (std::isnan(number)) return print("nan");
+  if (std::isinf(number)) return print("inf");
+  if (number > 4294967040.0f) return print("ovf");
+  if (number < -4294967040.0f) return print("ovf");
+  if (number < 0.0f) {
+    n += print('-');
+    number = -number;
+  }
+  float rounding = 0.5f;
+  for (uint8_t i = 0; i < digits; ++i) rounding /= 10.0f;
+  number += rounding;
+  uint32_t int_part = (uint32_t)number;
+  float remainder = number - (float)int_part;
+  n += print((unsigned long)int_part);
+  if (digits > 0) n += print('.');
+  while (digits-- > 0) {
+    remainder *= 10.0f;
+    unsigned int toPrint = (unsigned int)remainder;
+    n += print(toPrint);
+    remainder -= toPrint;
+  }
+  return n;
+}
+
+int HardwareSerial::availableForWrite(void) {
+  return 63; // SERIAL_TX_BUFFER_SIZE - 1, never full
+}
+
+void HardwareSerial::flush(void) {
+  fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+  return (fputc(b, stdout) == EOF) ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+#ifndef UNIT_TEST
+// Like main() of the core: setup() once, then loop(). The board runs loop()
+// forever, here the first argument is the number of passes (default 1, 0 - forever).
+int main(int argc, char *argv[]) {
+  unsigned long passes = (argc > 1) ? strtoul(argv[1], 0, 10) : 1;
+  setup();
+  for (unsigned long i = 0; passes == 0 || i < passes; i++)
+    loop();
+  Serial.flush();
+  return 0;
+}
+#endif
@@ -0,0 +1,100 @@
+// Arduino API subset for running the sketch on the host (pio run -e native_sketch)
+// AndrewBiz
+
+#ifndef ARDUINO_SHIM_H
+#define ARDUINO_SHIM_H
+#if defined(__AVR__)
+  #error lib/arduino_shim is for host builds, the board uses the Arduino core
+#endif
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000L // the Uno clock, the sketch converts micros() to cycles with it
+#endif
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// F("text") keeps the text in RAM, there is only one address space
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+// Time since the start of the program from the monotonic clock, wraps at
+// 32 bits like on the board
+unsigned long millis(void);
+unsigned long micros(void);
+#ifdef UNIT_TEST
+// Unit tests: the clock stands still at the time set here (0 at the start)
+void shim_set_micros(uint32_t us);
+#endif
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// avr-libc dtostrf: the float value of val (double is float on AVR) with prec
+// decimals and at most 8 significant digits, the rest are '0'. Right aligned
+// in width characters, left aligned for a negative width.
+char *dtostrf(double val, signed char width, unsigned char prec, char *s);
+
+// Print of the Arduino core: the same text for the same values, numbers
+// are 32 bits (long on AVR) and floats are printed in float precision
+class Print {
+private:
+  size_t printNumber(uint32_t n, uint8_t base);
+  size_t printFloat(float number, uint8_t digits);
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  virtual int availableForWrite() { return 0; }
+
+  size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+  size_t print(const char s[]) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char b, int base = DEC) { return print((unsigned long)b, base); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = DEC);
+  size_t print(unsigned long n, int base = DEC);
+  size_t print(double n, int digits = 2) { return printFloat((float)n, (uint8_t)digits); }
+
+  size_t println(void) { return write("\r\n"); }
+  template <class T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(T v, int base) { size_t n = print(v, base); return n + println(); }
+};
+
+// Serial goes to stdout at full speed, begin() ignores the baud rate
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  void end() { flush(); }
+  int available(void) { return 0; }
+  int read(void) { return -1; }
+  int availableForWrite(void);
+  void flush(void);
+  size_t write(uint8_t b);
+  size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+  operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// the sketch
+void setup(void);
+void loop(void);
+
+#endif
@@ -0,0 +1,7 @@
+// avr/io.h for host builds: there are no AVR registers
+// AndrewBiz
+
+#ifndef ARDUINO_SHIM_IO_H
+#define ARDUINO_SHIM_IO_H
+#include <inttypes.h>
+#endif
@@ -0,0 +1,24 @@
+// avr/pgmspace.h for host builds: flash is ordinary memory
+// AndrewBiz
+
+#ifndef ARDUINO_SHIM_PGMSPACE_H
+#define ARDUINO_SHIM_PGMSPACE_H
+#include <inttypes.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define PGM_P const char *
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+
+#endif
@@ -0,0 +1,25 @@
+//!
+//! @file               CycleBench.cpp
+//! @author             AndrewBiz
+//! @created            2026-10-17
+//! @brief              Host ticks of CycleBench.hpp (the board uses Timer1).
+
+#if !defined(__AVR__)
+
+#include <chrono>
+#include "CycleBench.hpp"
+
+namespace Bench
+{
+namespace detail
+{
+    uint32_t host_ticks()
+    {
+        return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+} // namespace detail
+} // namespace Bench
+
+#endif // #if !defined(__AVR__)
+// EOF
@@ -0,0 +1,175 @@
+//!
+//! @file               CycleBench.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-17
+//! @brief              CPU cycles of single calls, counted by Timer1.
+//! @details
+//!     Timer1 runs at the CPU clock (no prescaler), so TCNT1 counts cycles. A
+//!     sample is one call of the benchmarked function through a pointer, with
+//!     the interrupts off: the compiler can not move code across the call and
+//!     the millis() / UART interrupts do not add to it. The cycles of calling
+//!     an empty function are measured by begin() and subtracted.
+//!     A sample can take up to 2^17 - 1 cycles (8 ms at 16 MHz), the overflow
+//!     flag of the 16-bit counter counts one wrap.
+//!     Timer1 PWM (analogWrite on pins 9 and 10) does not work between begin()
+//!     and end(). Host builds have no Timer1, the ticks are steady_clock ns
+//!     there (tick_hz() tells which).
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef CYCLE_BENCH_H
+#define CYCLE_BENCH_H
+
+#include <stdint.h>
+#if defined(__AVR__)
+    #include <avr/io.h>
+    #include <avr/interrupt.h>
+#endif
+
+namespace Bench
+{
+//! @brief      Benchmarked function, i is the sample number (to pick operands).
+typedef void (*CycleFn)(uint8_t i);
+
+//! @brief      Most samples of one run (they are sorted on the stack).
+const uint8_t CYCLE_SAMPLES_MAX = 32;
+
+//! @brief      Cycles of one call, measurement overhead subtracted.
+struct CycleStats {
+    uint32_t min;
+    uint32_t median;
+    uint32_t max;
+};
+
+namespace detail
+{
+    inline void cycle_empty(uint8_t)
+    {
+    }
+
+#if !defined(__AVR__)
+    //! @brief      steady_clock in ns (CycleBench.cpp, the time headers declare
+    //!             ::clock(), a name sketches use).
+    uint32_t host_ticks();
+#endif
+} // namespace detail
+
+class CycleTimer {
+private:
+    uint32_t _overhead;
+#if defined(__AVR__)
+    uint8_t _tccr1a;
+    uint8_t _tccr1b;
+    uint8_t _timsk1;
+#endif
+
+    // ticks of the call, overhead included
+    static uint32_t _ticks(CycleFn fn, uint8_t i)
+    {
+        // an unknown pointer: the call can not be inlined
+        asm volatile ("" : "+r" (fn));
+#if defined(__AVR__)
+        uint8_t sreg = SREG;
+        cli();
+        TCNT1 = 0;
+        TIFR1 = _BV(TOV1); // cleared by writing 1
+        fn(i);
+        uint16_t t = TCNT1;
+        bool wrapped = (TIFR1 & _BV(TOV1)) != 0;
+        SREG = sreg;
+        // a wrap just after t was read is not counted
+        return t + ((wrapped && t < 0x8000) ? 0x10000UL : 0);
+#else
+        uint32_t t0 = detail::host_ticks();
+        fn(i);
+        return detail::host_ticks() - t0;
+#endif
+    }
+
+public:
+    CycleTimer() :
+        _overhead(0)
+    {
+    }
+
+    //! @brief      Ticks per second: F_CPU on the board, 10^9 on the host.
+    static uint32_t tick_hz()
+    {
+#if defined(__AVR__)
+        return F_CPU;
+#else
+        return 1000000000UL;
+#endif
+    }
+
+    //! @brief      Starts Timer1 at the CPU clock and measures the overhead.
+    void begin()
+    {
+#if defined(__AVR__)
+        _tccr1a = TCCR1A;
+        _tccr1b = TCCR1B;
+        _timsk1 = TIMSK1;
+        TIMSK1 = 0;
+        TCCR1A = 0;
+        TCCR1B = _BV(CS10); // normal mode, clk/1
+#endif
+        _overhead = 0xffffffffUL;
+        for (uint8_t i = 0; i < 16; i++) {
+            uint32_t t = _ticks(detail::cycle_empty, i);
+            if (t < _overhead)
+                _overhead = t;
+        }
+    }
+
+    //! @brief      Gives Timer1 back as it was before begin().
+    void end()
+    {
+#if defined(__AVR__)
+        TCCR1B = _tccr1b;
+        TCCR1A = _tccr1a;
+        TIMSK1 = _timsk1;
+#endif
+    }
+
+    //! @brief      Ticks of calling an empty function (subtracted from the samples).
+    uint32_t overhead() const
+    {
+        return _overhead;
+    }
+
+    //! @brief      Ticks of one call fn(i).
+    uint32_t sample(CycleFn fn, uint8_t i) const
+    {
+        uint32_t t = _ticks(fn, i);
+        return (t > _overhead) ? t - _overhead : 0;
+    }
+
+    //! @brief      Calls fn(0) .. fn(samples - 1), one sample each.
+    CycleStats run(CycleFn fn, uint8_t samples) const
+    {
+        uint32_t t[CYCLE_SAMPLES_MAX];
+        if (samples == 0)
+            samples = 1;
+        if (samples > CYCLE_SAMPLES_MAX)
+            samples = CYCLE_SAMPLES_MAX;
+        // insertion sort as they come
+        for (uint8_t i = 0; i < samples; i++) {
+            uint32_t v = sample(fn, i);
+            uint8_t j = i;
+            for (; j > 0 && t[j - 1] > v; j--)
+                t[j] = t[j - 1];
+            t[j] = v;
+        }
+        CycleStats res;
+        res.min = t[0];
+        res.median = t[samples / 2];
+        res.max = t[samples - 1];
+        return res;
+    }
+}; // class
+} // namespace Bench
+
+#endif // #ifndef CYCLE_BENCH_H
+// EOF
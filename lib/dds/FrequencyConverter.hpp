@@ -0,0 +1,71 @@
+//!
+//! @file               FrequencyConverter.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              DDS tuning word to frequency conversion without 64x64 multiplication.
+//! @details
+//!     freq = tword * clock / 2^32
+//!     clock / 2^32 as 0.32 fixed point number is clock itself (clock < 2^32), so one
+//!     32x32->64 widening multiplication gives freq as 32.32 fixed point number:
+//!     upper word - Hz, lower word - fraction of Hz.
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef FREQUENCY_CONVERTER_H
+#define FREQUENCY_CONVERTER_H
+
+#include <stdint.h>
+
+namespace Dds
+{
+//! @brief      Frequency split for printing: hz.centi
+struct Frequency {
+    uint32_t hz;      // integer part, Hz
+    uint8_t centi;    // fractional part, 1/100 Hz (0..99), rounded down
+
+    //! @brief      Frequency in 1/100 Hz (wraps above 42949672.95 Hz).
+    uint32_t hz100() const
+    {
+        return hz * 100 + centi;
+    }
+
+    //! @brief      Writes 2 digits of the fractional part (with leading zero) and terminating 0.
+    void centi_to_chars(char *buf) const
+    {
+        buf[0] = '0' + centi / 10;
+        buf[1] = '0' + centi % 10;
+        buf[2] = 0;
+    }
+};
+
+//! @brief      Converts 32-bit DDS tuning word to frequency.
+//! @details    Bit-exact with the 64-bit reference ((uint64_t)tword * clock * 100) >> 32
+//!             (rounded down to 1/100 Hz). Unlike the reference the product can not
+//!             overflow, so it is exact for every tword.
+class FrequencyConverter {
+private:
+    uint32_t _scale;  // clock / 2^32, 0.32 fixed point
+
+public:
+    constexpr FrequencyConverter(uint32_t clock) :
+        _scale(clock)
+    {
+    }
+
+    Frequency convert(uint32_t tword) const
+    {
+        // avr-gcc maps the 32x32->64 product to __umulsidi3, not to the 64x64 __muldi3
+        uint64_t f = (uint64_t)tword * _scale;
+        Frequency res;
+        res.hz = (uint32_t)(f >> 32);
+        // fraction * 100 / 2^32, again a 32x32->64 product
+        res.centi = (uint8_t)(((uint64_t)(uint32_t)f * 100) >> 32);
+        return res;
+    }
+}; // class
+} // namespace Dds
+
+#endif // #ifndef FREQUENCY_CONVERTER_H
+// EOF
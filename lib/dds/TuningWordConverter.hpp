@@ -0,0 +1,136 @@
+//!
+//! @file               TuningWordConverter.hpp
+//! @author             AndrewBiz
+//! @created            2026-10-16
+//! @brief              Frequency to DDS tuning word conversion without 64-bit division.
+//! @details
+//!     tword = freq * 2^32 / clock
+//!     The division by clock is replaced by a multiplication with a reciprocal
+//!     precomputed once for the given clock (see Reciprocal below).
+
+#ifndef __cplusplus
+    #error Please build with C++ compiler
+#endif
+
+#ifndef TUNING_WORD_CONVERTER_H
+#define TUNING_WORD_CONVERTER_H
+
+#include <stdint.h>
+#include <Fp32s.hpp>
+
+namespace Dds
+{
+namespace detail
+{
+    // floor(n * m / 2^32) built from two 32x32->64 multiplications
+    inline uint64_t mul_u32_u64_shr32(uint32_t n, uint64_t m)
+    {
+        uint64_t lo = (uint64_t)n * (uint32_t)m;
+        uint64_t hi = (uint64_t)n * (uint32_t)(m >> 32);
+        return hi + (lo >> 32);
+    }
+
+    // The helpers below are C++11 constexpr, so the loops are written as tail
+    // recursion (turned back into loops by the optimizer for runtime use).
+
+    // d without the powers of 2 it shares with 2^32
+    constexpr uint64_t strip_pow2(uint64_t d, uint8_t n = 0)
+    {
+        return (n == 32 || (d & 1) != 0) ? d : strip_pow2(d >> 1, n + 1);
+    }
+
+    constexpr uint8_t bit_length(uint64_t x, uint8_t n = 0)
+    {
+        return (x == 0) ? n : bit_length(x >> 1, n + 1);
+    }
+
+    // ceil(2^bits / d) by bit by bit long division, r - running remainder
+    constexpr uint64_t div_pow2_ceil(uint64_t d, uint8_t bits, uint64_t r = 1, uint64_t m = 0)
+    {
+        return (bits == 0) ? m + (r != 0 ? 1 : 0) :
+            ((r << 1) >= d) ? div_pow2_ceil(d, bits - 1, (r << 1) - d, (m << 1) | 1) :
+                              div_pow2_ceil(d, bits - 1, r << 1, m << 1);
+    }
+} // namespace detail
+
+//! @brief      Reciprocal of the divisor d, gives floor(n * 2^32 / d) for any 32-bit n.
+//! @details    m = ceil(2^(shift + 32) / d), the quotient is (n * m) >> shift.
+//!             With g = gcd(2^32, d) the remainder of n * 2^32 / d never exceeds d - g,
+//!             so the error of the reciprocal (< n / 2^shift) can not change the quotient
+//!             as long as 2^shift >= 2^32 * d / g. That holds for the shift chosen below.
+//!             m needs 65 bits when d is odd (or 2), bit 64 is kept in m_hi. d must be >= 2.
+class Reciprocal {
+public:
+    //! @brief      Magic multiplier, bits 0..63.
+    uint64_t m;
+
+    //! @brief      Bit 64 of the multiplier, set when m > 2^64 - 1 (d <= 2^(shift - 32)).
+    bool m_hi;
+
+    //! @brief      Total right shift applied to n * m (always >= 32).
+    uint8_t shift;
+
+    Reciprocal()
+    {
+    }
+
+    constexpr Reciprocal(uint64_t d) :
+        // the long division keeps the low 64 bits of m
+        m(detail::div_pow2_ceil(d, 64 + detail::bit_length(detail::strip_pow2(d)))),
+        m_hi(d <= ((uint64_t)1 << detail::bit_length(detail::strip_pow2(d)))),
+        shift(32 + detail::bit_length(detail::strip_pow2(d)))
+    {
+    }
+
+    //! @brief      Returns floor(n * 2^32 / d).
+    uint64_t apply(uint32_t n) const
+    {
+        uint64_t t = detail::mul_u32_u64_shr32(n, m);
+        if (!m_hi)
+            return t >> (shift - 32);
+        // + n * 2^32 for bit 64 of m, halved first so the sum fits 64 bits
+        return ((t >> 1) + ((uint64_t)n << 31)) >> (shift - 33);
+    }
+};
+
+//! @brief      Converts frequency to the 32-bit DDS tuning word using only multiply and shift.
+//! @details    Results are bit-exact with the 64-bit integer reference
+//!             (uint32_t)(((uint64_t)freq << 32) / clock), i.e. rounded down, for every
+//!             32-bit input (freq above clock wraps the same way as the reference).
+//!             The clock must be at least 2, an odd clock takes the 65-bit multiplier.
+class TuningWordConverter {
+private:
+    Reciprocal _hz;     // divisor clock
+    Reciprocal _hz100;  // divisor 100 * clock
+
+public:
+    constexpr TuningWordConverter(uint32_t clock) :
+        _hz(clock),
+        _hz100((uint64_t)clock * 100)
+    {
+    }
+
+    //! @brief      freq in Hz.
+    uint32_t from_hz(uint32_t freq) const
+    {
+        return (uint32_t)_hz.apply(freq);
+    }
+
+    //! @brief      freq in 1/100 Hz, same as ((((uint64_t)freq100 << 32) / clock) / 100).
+    uint32_t from_hz100(uint32_t freq100) const
+    {
+        return (uint32_t)_hz100.apply(freq100);
+    }
+
+    //! @brief      freq in Hz as fixed point number (must not be negative).
+    //! @details    floor(floor(x / clock) / 2^q) == floor(x / (clock * 2^q)), so the
+    //!             Hz reciprocal serves any q.
+    uint32_t from_fp(const Fp::Fp32s &freq) const
+    {
+        return (uint32_t)(_hz.apply((uint32_t)freq.rawVal) >> freq.q);
+    }
+}; // class
+} // namespace Dds
+
+#endif // #ifndef TUNING_WORD_CONVERTER_H
+// EOF
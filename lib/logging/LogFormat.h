@@ -0,0 +1,178 @@
+// Compile-time parsing of the Logging format strings
+// Modified by AndrewBiz
+
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+#include <inttypes.h>
+
+// precision of a specifier without one
+#define LOG_PREC_NONE 0xff
+
+// Fixed point value: a class with the members rawVal and q (Fp32s, Fp64s),
+// value is the size of rawVal in bits, 0 for anything else
+template <class T> struct LogFixBits {
+  template <class U> static constexpr uint8_t bits(decltype(&U::rawVal), decltype(&U::q))
+  {
+    return sizeof(U::rawVal) * 8;
+  }
+  template <class U> static constexpr uint8_t bits(...)
+  {
+    return 0;
+  }
+  static constexpr uint8_t value = bits<T>(0, 0);
+};
+
+// Argument types as the format checks see them (no <type_traits> on AVR)
+template <class T> struct LogType {
+  static constexpr bool integral = false;
+  static constexpr bool is_signed = false;
+  static constexpr bool is_char = false;
+  static constexpr bool is_bool = false;
+  static constexpr bool is_str = false;
+  static constexpr uint8_t fix = LogFixBits<T>::value;
+};
+
+#define LOG_TYPE_INT(T, c) \
+  template <> struct LogType<T> { \
+    static constexpr bool integral = true; \
+    static constexpr bool is_signed = (T)-1 < (T)0; \
+    static constexpr bool is_char = c; \
+    static constexpr bool is_bool = false; \
+    static constexpr bool is_str = false; \
+    static constexpr uint8_t fix = 0; \
+  };
+LOG_TYPE_INT(char, true)
+LOG_TYPE_INT(signed char, false)
+LOG_TYPE_INT(unsigned char, false)
+LOG_TYPE_INT(short, false)
+LOG_TYPE_INT(unsigned short, false)
+LOG_TYPE_INT(int, false)
+LOG_TYPE_INT(unsigned int, false)
+LOG_TYPE_INT(long, false)
+LOG_TYPE_INT(unsigned long, false)
+LOG_TYPE_INT(long long, false)
+LOG_TYPE_INT(unsigned long long, false)
+#undef LOG_TYPE_INT
+
+template <> struct LogType<bool> {
+  static constexpr bool integral = true;
+  static constexpr bool is_signed = false;
+  static constexpr bool is_char = false;
+  static constexpr bool is_bool = true;
+  static constexpr bool is_str = false;
+  static constexpr uint8_t fix = 0;
+};
+
+template <> struct LogType<const char *> {
+  static constexpr bool integral = false;
+  static constexpr bool is_signed = false;
+  static constexpr bool is_char = false;
+  static constexpr bool is_bool = false;
+  static constexpr bool is_str = true;
+  static constexpr uint8_t fix = 0;
+};
+
+template <> struct LogType<char *> : LogType<const char *> {};
+
+// Every value of T is a value of the signed type of size n
+template <class T> constexpr bool log_fits_signed(uint8_t n)
+{
+  return LogType<T>::integral && !LogType<T>::is_bool &&
+    (LogType<T>::is_signed ? sizeof(T) <= n : sizeof(T) < n);
+}
+
+// Does the specifier c take an argument of type T? Signedness and size must
+// fit what the specifier prints: %d/%i an int, %l a long, %x/%X/%b/%B up to
+// an int, %u an unsigned of up to 32 bits, %y/%Y a byte, %c a char, %t/%T a bool,
+// %L/%U a signed/unsigned of up to 64 bits, %H up to 64 bits, %q a 32-bit and
+// %Q a 64-bit fixed point value.
+template <class T> constexpr bool log_accepts(char c)
+{
+  return (c == 'd' || c == 'i') ? log_fits_signed<T>(sizeof(int)) :
+    (c == 'x' || c == 'X' || c == 'b' || c == 'B') ? LogType<T>::integral && sizeof(T) <= sizeof(int) :
+    (c == 'l') ? log_fits_signed<T>(sizeof(long)) :
+    (c == 'u') ? LogType<T>::integral && !LogType<T>::is_signed && !LogType<T>::is_bool && sizeof(T) <= sizeof(uint32_t) :
+    (c == 'y' || c == 'Y') ? LogType<T>::integral && sizeof(T) == 1 :
+    (c == 'c') ? LogType<T>::is_char :
+    (c == 't' || c == 'T') ? LogType<T>::is_bool :
+    (c == 's') ? LogType<T>::is_str :
+    (c == 'L') ? log_fits_signed<T>(8) :
+    (c == 'U') ? LogType<T>::integral && !LogType<T>::is_signed && !LogType<T>::is_bool :
+    (c == 'H') ? LogType<T>::integral && !LogType<T>::is_bool :
+    (c == 'q') ? LogType<T>::fix == 32 :
+    (c == 'Q') ? LogType<T>::fix == 64 : false;
+}
+
+constexpr bool log_is_spec(char c)
+{
+  return c == 'd' || c == 'i' || c == 'x' || c == 'X' || c == 'b' || c == 'B' || c == 'l' ||
+    c == 'u' || c == 'y' || c == 'Y' || c == 'c' || c == 't' || c == 'T' || c == 's' ||
+    c == 'L' || c == 'U' || c == 'H' || c == 'q' || c == 'Q';
+}
+
+constexpr bool log_is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// The specifiers with a precision digit ("%2q")
+constexpr bool log_has_prec(const char *s, uint8_t pct)
+{
+  return log_is_digit(s[pct + 1]) && (s[pct + 2] == 'q' || s[pct + 2] == 'Q');
+}
+
+// specifier of the '%' at pct (0 for a digit not followed by q or Q)
+constexpr char log_spec(const char *s, uint8_t pct)
+{
+  return log_has_prec(s, pct) ? s[pct + 2] : log_is_digit(s[pct + 1]) ? 0 : s[pct + 1];
+}
+
+// position after the specifier of the '%' at pct
+constexpr uint8_t log_spec_end(const char *s, uint8_t pct)
+{
+  return pct + (log_has_prec(s, pct) ? 3 : 2);
+}
+
+constexpr uint8_t log_prec(const char *s, uint8_t pct)
+{
+  return log_has_prec(s, pct) ? s[pct + 1] - '0' : LOG_PREC_NONE;
+}
+
+// position of the next '%' (or of the final '\0') from pos on
+constexpr uint8_t log_next_pct(const char *s, uint8_t pos)
+{
+  return (s[pos] == 0 || s[pos] == '%') ? pos : log_next_pct(s, pos + 1);
+}
+
+constexpr uint8_t log_length(const char *s, uint8_t pos = 0)
+{
+  return (s[pos] == 0) ? pos : log_length(s, pos + 1);
+}
+
+// Checks the format from pos on against the argument types: every
+// specifier takes the next argument, "%%" none, anything else fails
+template <class... A> struct LogArgs;
+
+template <> struct LogArgs<> {
+  static constexpr bool check(const char *s, uint8_t pos)
+  {
+    return (s[log_next_pct(s, pos)] == 0) ? true :
+      (s[log_next_pct(s, pos) + 1] == '%') ? check(s, log_next_pct(s, pos) + 2) : false;
+  }
+};
+
+template <class T, class... R> struct LogArgs<T, R...> {
+  static constexpr bool check(const char *s, uint8_t pos)
+  {
+    return (s[log_next_pct(s, pos)] == 0) ? false :
+      (s[log_next_pct(s, pos) + 1] == '%') ? check(s, log_next_pct(s, pos) + 2) :
+      log_accepts<T>(log_spec(s, log_next_pct(s, pos))) &&
+        LogArgs<R...>::check(s, log_spec_end(s, log_next_pct(s, pos)));
+  }
+};
+
+template <bool b> struct LogBool {};
+
+template <char c, uint8_t prec = LOG_PREC_NONE> struct LogSpec {};
+
+#endif
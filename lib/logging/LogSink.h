@@ -0,0 +1,91 @@
+// Output of the Logging library, chosen at compile time
+// Modified by AndrewBiz
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+#include <inttypes.h>
+
+// Build with -DLOG_SINK=... to pick where the log goes. Only the chosen
+// sink is used, the others are inline code that is never emitted.
+#define LOG_SINK_UART 0 // Serial (buffered by HardwareSerial and in binary mode by Logging)
+#define LOG_SINK_RAM  1 // capture buffer in RAM, for tests
+#define LOG_SINK_FILE 2 // stdout or a file, host builds only
+#define LOG_SINK_NULL 3 // nothing, for benchmarks without the UART
+#ifndef LOG_SINK
+#define LOG_SINK LOG_SINK_UART
+#endif
+
+// size of the capture buffer of LOG_SINK_RAM
+#ifndef LOG_CAPTURE_SIZE
+#define LOG_CAPTURE_SIZE 256
+#endif
+
+// Every sink has begin(baud), write(byte), write(buf, len) and room(): the
+// bytes that can be written without waiting
+
+class LogSinkUart {
+public:
+  void begin(long baud) { Serial.begin(baud); }
+  void write(uint8_t b) { Serial.write(b); }
+  void write(const uint8_t *buf, uint8_t len) { Serial.write(buf, len); }
+  int room() { return Serial.availableForWrite(); }
+};
+
+// Keeps the first LOG_CAPTURE_SIZE bytes, the rest is counted in lost
+class LogSinkRam {
+public:
+  uint8_t data[LOG_CAPTURE_SIZE];
+  uint16_t len;
+  uint16_t lost;
+
+  void begin(long) { clear(); }
+  void clear() { len = 0; lost = 0; }
+  void write(uint8_t b) {
+    if (len < LOG_CAPTURE_SIZE) data[len++] = b;
+    else lost++;
+  }
+  void write(const uint8_t *buf, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) write(buf[i]);
+  }
+  int room() { return 0x7fff; }
+};
+
+#if LOG_SINK == LOG_SINK_FILE
+#if defined(__AVR__)
+  #error LOG_SINK_FILE is for host builds
+#endif
+#include <stdio.h>
+
+// stdout unless open() gave another file
+class LogSinkFile {
+private:
+  FILE *_f;
+public:
+  LogSinkFile() : _f(0) {}
+  void open(FILE *f) { _f = f; }
+  void begin(long) { if (_f == 0) _f = stdout; }
+  void write(uint8_t b) { fputc(b, _f); }
+  void write(const uint8_t *buf, uint8_t len) { fwrite(buf, 1, len, _f); }
+  int room() { return 0x7fff; }
+};
+#endif
+
+class LogSinkNull {
+public:
+  void begin(long) {}
+  void write(uint8_t) {}
+  void write(const uint8_t *, uint8_t) {}
+  int room() { return 0x7fff; }
+};
+
+#if LOG_SINK == LOG_SINK_RAM
+typedef LogSinkRam LogSinkType;
+#elif LOG_SINK == LOG_SINK_FILE
+typedef LogSinkFile LogSinkType;
+#elif LOG_SINK == LOG_SINK_NULL
+typedef LogSinkNull LogSinkType;
+#else
+typedef LogSinkUart LogSinkType;
+#endif
+
+#endif
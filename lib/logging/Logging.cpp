@@ -2,141 +2,582 @@
 // Modified by AndrewBiz
 
 #include <Logging.h>
+#include <FpChars.hpp>
 
-void Logging::Init(int level, long baud, bool print_ts, bool auto_ln){
-  _level = constrain(level,LOG_LEVEL_NOOUTPUT,LOG_LEVEL_VERBOSE);
+void Logging::Init(int level, long baud, uint8_t print_ts, bool auto_ln, bool binary){
+  // records of an earlier Init go out first (the buffer of the global Log
+  // starts empty: zero initialized)
+  Flush();
+  SetLevel(level);
   _baud = baud;
-  _print_ts = print_ts;
+  _sink.begin(_baud);
+  SetMode(print_ts, auto_ln, binary);
+}
+
+void Logging::SetLevel(int level){
+  _level = constrain(level,LOG_LEVEL_NOOUTPUT,LOG_LEVEL_VERBOSE);
+}
+
+void Logging::SetMode(uint8_t print_ts, bool auto_ln, bool binary){
+  // the buffered records belong to the old mode
+  Flush();
+  _ts = print_ts;
   _auto_ln = auto_ln;
-  Serial.begin(_baud);
+  _binary = LOG_BINARY_MODE && (binary || LOG_TOKENIZED);
+  _ts_last = (_ts & LOG_TS_MICROS) ? micros() : millis();
+  if (_binary) {
+    // session record: the time stamp mode for the decoder
+    const uint8_t rec[] = {LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, _ts};
+    push(rec, sizeof(rec));
+  }
 }
 
-void Logging::print(const __FlashStringHelper *format, va_list args) {
+void Logging::print(LogLine &line, const __FlashStringHelper *format, va_list *args) {
   PGM_P p = reinterpret_cast<PGM_P>(format);
   char c = pgm_read_byte(p++);
   for(;c != 0; c = pgm_read_byte(p++)){
     if (c == '%') {
       c = pgm_read_byte(p++);
-      printFormat(c, &args);
+      printFormat(line, c, args);
     } else {
-      Serial.print(c);
+      line.put(c);
     }
   }
 
 }
 
-void Logging::print(const char *format, va_list args) {
+void Logging::print(LogLine &line, const char *format, va_list *args) {
   for (; *format != 0; ++format) {
     if (*format == '%') {
       ++format;
-      printFormat(*format, &args);
+      printFormat(line, *format, args);
     } else {
-      Serial.print(*format);
+      line.put(*format);
     }
   }
 }
 
-void Logging::printFormat(const char format, va_list *args) {
+void Logging::printFormat(LogLine &line, const char format, va_list *args) {
   if (format == '\0') return;
 
   if (format == '%') {
-    Serial.print(format);
+    line.put(format);
     return;
   }
 
   if( format == 's' ) {
-    register char *s = (char *)va_arg( *args, int );
-    Serial.print(s);
+    const char *s = va_arg( *args, const char * );
+    line.str(s);
     return;
   }
 
   if( format == 'd' || format == 'i') {
-    Serial.print(va_arg( *args, int ),DEC);
+    line.sdec(va_arg( *args, int ));
     return;
   }
 
   if( format == 'x' ) {
-    Serial.print(va_arg( *args, int ),HEX);
+    line.num((long)va_arg( *args, int ),HEX);
     return;
   }
 
   if( format == 'X' ) {
-    Serial.print("0x");
-    Serial.print(va_arg( *args, int ),HEX);
+    line.str_P(PSTR("0x"));
+    line.num((long)va_arg( *args, int ),HEX);
     return;
   }
 
   if( format == 'b' ) {
-    Serial.print(va_arg( *args, int ),BIN);
+    line.num((long)va_arg( *args, int ),BIN);
     return;
   }
 
   if( format == 'B' ) {
-    Serial.print("0b");
-    Serial.print(va_arg( *args, int ),BIN);
+    line.str_P(PSTR("0b"));
+    line.num((long)va_arg( *args, int ),BIN);
     return;
   }
 
   if( format == 'y' ) {
-    print_u8_to_bin( (uint8_t) (va_arg(*args, int) &0xff) );
+    line.bin8( (uint8_t) (va_arg(*args, int) &0xff) );
     return;
   }
 
   if( format == 'Y' ) {
-    Serial.print("0b");
-    print_u8_to_bin( (uint8_t) (va_arg(*args, int) &0xff) );
+    line.str_P(PSTR("0b"));
+    line.bin8( (uint8_t) (va_arg(*args, int) &0xff) );
     return;
   }
 
   if( format == 'l' ) {
-    Serial.print(va_arg( *args, long ),DEC);
+    line.sdec(va_arg( *args, long ));
     return;
   }
 
   if( format == 'u' ) {
-    Serial.print(va_arg( *args, uint32_t ),DEC);
+    line.num(va_arg( *args, uint32_t ),DEC);
+    return;
+  }
+
+  if( format == 'L' ) {
+    line.s64(va_arg( *args, int64_t ));
+    return;
+  }
+
+  if( format == 'U' ) {
+    line.u64(va_arg( *args, uint64_t ));
+    return;
+  }
+
+  if( format == 'H' ) {
+    line.hex64(va_arg( *args, uint64_t ));
     return;
   }
 
   if( format == 'c' ) {
-    Serial.print(va_arg( *args, int ));
+    line.sdec(va_arg( *args, int ));
     return;
   }
 
   if( format == 't' ) {
     if (va_arg( *args, int ) == 1) {
-      Serial.print("T");
+      line.put('T');
     }
     else {
-      Serial.print("F");
+      line.put('F');
     }
     return;
   }
 
   if( format == 'T' ) {
     if (va_arg( *args, int ) == 1) {
-      Serial.print(F("true"));
+      line.str_P(PSTR("true"));
     }
     else {
-      Serial.print(F("false"));
+      line.str_P(PSTR("false"));
     }
     return;
   }
 }
 
-// Print of the Time Stamp
-void Logging::print_ts() {
-  if( _print_ts ) {
-    char tsbuf[16];
-    sprintf( tsbuf, "%010lu ms: ", millis() );
-    Serial.print(tsbuf);
+// Time stamp value of the mode, the delta is taken from message to message
+uint32_t Logging::ts_now() {
+  uint32_t t = (_ts & LOG_TS_MICROS) ? micros() : millis();
+  if (_ts & LOG_TS_DELTA) {
+    uint32_t d = t - _ts_last;
+    _ts_last = t;
+    return d;
+  }
+  return t;
+}
+
+// Print of the Time Stamp, 10 digits wide
+void Logging::print_ts(LogLine &line) {
+  if( _ts != LOG_TS_NONE ) {
+    uint32_t t = ts_now();
+    if (_ts & LOG_TS_DELTA) line.put('+');
+    line.dec_fixed(t, 10);
+    line.str_P((_ts & LOG_TS_MICROS) ? PSTR(" us: ") : PSTR(" ms: "));
+  }
+}
+
+// Start of a text line: error prefix and time stamp
+void Logging::line_begin(LogLine &line, uint8_t level) {
+  line.len = 0;
+  if (level == LOG_LEVEL_ERRORS) line.str_P(PSTR("ERROR: "));
+  print_ts(line);
+}
+
+// End of a text line: CR LF as Serial.println, then the whole line to the sink
+void Logging::line_end(LogLine &line) {
+  if (_auto_ln) {
+    line.put('\r');
+    line.put('\n');
+  }
+  line.flush();
+}
+
+// Text line
+
+void LogLine::put(char c) {
+  if (len == LOG_LINE_SIZE) flush();
+  buf[len++] = c;
+}
+
+// len chars from flash
+void LogLine::text_P(PGM_P p, uint8_t n) {
+  for (; n != 0; n--) put((char)pgm_read_byte(p++));
+}
+
+void LogLine::str(const char *s) {
+  for (; *s != 0; s++) put(*s);
+}
+
+void LogLine::str_P(PGM_P p) {
+  for (char c = pgm_read_byte(p); c != 0; c = pgm_read_byte(++p)) put(c);
+}
+
+// Digits of v as Print::print(unsigned long, base) writes them: DEC, HEX
+// (upper case) or BIN, no leading zeros
+void LogLine::num(uint32_t v, uint8_t base) {
+  char rev[32];
+  uint8_t n = 0;
+  if (base == DEC) {
+    n = Fp::detail::u64_to_digits(v, rev);
+  } else {
+    uint8_t bits = (base == HEX) ? 4 : 1;
+    do {
+      uint8_t c = (uint8_t)v & (base - 1);
+      rev[n++] = (c < 10) ? '0' + c : 'A' - 10 + c;
+      v >>= bits;
+    } while (v != 0);
+  }
+  while (n != 0) put(rev[--n]);
+}
+
+// Signed decimal as Print::print(long, DEC)
+void LogLine::sdec(long v) {
+  if (v < 0) {
+    put('-');
+    num(0 - (uint32_t)v, DEC);
+  } else {
+    num((uint32_t)v, DEC);
+  }
+}
+
+// 64-bit decimal, divided by 10 as a multiplication by the reciprocal (FpChars.hpp)
+void LogLine::u64(uint64_t v) {
+  char rev[20];
+  uint8_t n = Fp::detail::u64_to_digits(v, rev);
+  while (n != 0) put(rev[--n]);
+}
+
+void LogLine::s64(int64_t v) {
+  if (v < 0) {
+    put('-');
+    u64(0 - (uint64_t)v);
+  } else {
+    u64((uint64_t)v);
+  }
+}
+
+// 64-bit HEX, no leading zeros, as two 32-bit halves
+void LogLine::hex64(uint64_t v) {
+  uint32_t hi = (uint32_t)(v >> 32);
+  uint32_t lo = (uint32_t)v;
+  if (hi == 0) {
+    num(lo, HEX);
+    return;
+  }
+  num(hi, HEX);
+  for (int8_t sh = 28; sh >= 0; sh -= 4) {
+    uint8_t c = (uint8_t)(lo >> sh) & 0x0f;
+    put((c < 10) ? '0' + c : 'A' - 10 + c);
+  }
+}
+
+// v as width decimal digits with leading zeros (the lowest ones when v
+// is longer), written from the right straight into the line
+void LogLine::dec_fixed(uint32_t v, uint8_t width) {
+  if (len > LOG_LINE_SIZE - width) flush();
+  for (uint8_t i = width; i != 0; i--) {
+    uint32_t d = Fp::detail::div10_u32(v);
+    buf[len + i - 1] = '0' + (uint8_t)((uint8_t)v - (uint8_t)d * 10);
+    v = d;
+  }
+  len += width;
+}
+
+// BINary with leading zeros, 8 char wide
+void LogLine::bin8(uint8_t b) {
+  for (uint8_t z = 128; z > 0; z >>= 1) put((b & z) ? '1' : '0');
+}
+
+// HEX byte with leading zero
+void LogLine::hex2(uint8_t b) {
+  uint8_t c = b >> 4;
+  put((c < 10) ? '0' + c : 'A' - 10 + c);
+  c = b & 0x0f;
+  put((c < 10) ? '0' + c : 'A' - 10 + c);
+}
+
+// Decimals of a %q / %Q without precision: round(q * log10(2)), at most 9
+// (the same as Fp32s::qd)
+static uint8_t fix_digits(uint8_t q, uint8_t digits) {
+  if (digits != LOG_PREC_NONE) return digits;
+  uint8_t d = (uint8_t)(((uint16_t)q * 77 + 128) >> 8);
+  return (d > 9) ? 9 : d;
+}
+
+// Fixed point text straight into the line, integer digits only (FpChars.hpp)
+void LogLine::fix32(int32_t raw, uint8_t q, uint8_t digits) {
+  if (len > LOG_LINE_SIZE - LOG_FIX_CHARS) flush();
+  len += Fp::detail::fix32_to_chars(buf + len, raw, q, fix_digits(q, digits));
+}
+
+void LogLine::fix64(int64_t raw, uint8_t q, uint8_t digits) {
+  if (len > LOG_LINE_SIZE - LOG_FIX_CHARS) flush();
+  len += Fp::detail::fix64_to_chars(buf + len, raw, q, fix_digits(q, digits));
+}
+
+// The line so far to the sink in one call
+void LogLine::flush() {
+  if (len != 0) Log.Sink().write((const uint8_t *)buf, len);
+  len = 0;
+}
+
+// Binary mode
+
+// Appends n little endian bytes of v, if they fit
+void LogRecord::le(uint32_t v, uint8_t n) {
+  if (pos + n > LOG_RECORD_SIZE) { pos = LOG_RECORD_SIZE + 1; return; }
+  for (; n != 0; n--, v >>= 8) buf[pos++] = (uint8_t)v;
+}
+
+// Appends v as a varint: 7 bits per byte, lowest first, top bit set on all but the last
+void LogRecord::varint(uint32_t v) {
+  for (;;) {
+    if (pos >= LOG_RECORD_SIZE) { pos = LOG_RECORD_SIZE + 1; return; }
+    if (v < 0x80) break;
+    buf[pos++] = (uint8_t)v | 0x80;
+    v >>= 7;
+  }
+  buf[pos++] = (uint8_t)v;
+}
+
+// Appends the text and its '\0'
+void LogRecord::str(const char *s) {
+  do {
+    if (pos >= LOG_RECORD_SIZE) { pos = LOG_RECORD_SIZE + 1; return; }
+    buf[pos++] = *s;
+  } while (*s++ != 0);
+}
+
+// Signed argument: zigzag varint when tokenized, else 4 bytes sign extended
+// (the text mode prints x and b of int as unsigned long)
+void LogRecord::sint(long v) {
+  if (LOG_TOKENIZED) {
+    varint(((uint32_t)v << 1) ^ (uint32_t)(v < 0 ? -1L : 0L));
+  } else {
+    le((uint32_t)v, 4);
+  }
+}
+
+// varint of a 64-bit value, the upper half only when it is needed
+void LogRecord::varint64(uint64_t v) {
+  while ((v >> 32) != 0) {
+    le((uint8_t)v | 0x80, 1);
+    v >>= 7;
+  }
+  varint((uint32_t)v);
+}
+
+// 64-bit signed argument: zigzag varint when tokenized, else 8 bytes
+void LogRecord::sint64(int64_t v) {
+  if (LOG_TOKENIZED) {
+    varint64(((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+  } else {
+    le((uint32_t)v, 4);
+    le((uint32_t)((uint64_t)v >> 32), 4);
+  }
+}
+
+void LogRecord::uint64(uint64_t v) {
+  if (LOG_TOKENIZED) {
+    varint64(v);
+  } else {
+    le((uint32_t)v, 4);
+    le((uint32_t)(v >> 32), 4);
+  }
+}
+
+void LogRecord::uint(uint32_t v) {
+  if (LOG_TOKENIZED) {
+    varint(v);
+  } else {
+    le(v, 4);
+  }
+}
+
+// Closes the record, a record cut at LOG_RECORD_SIZE keeps the arguments
+// that were complete
+uint8_t LogRecord::end() {
+  if (pos > LOG_RECORD_SIZE) pos = LOG_RECORD_SIZE;
+  buf[1] = pos - 2;
+  return pos;
+}
+
+// Header up to the format: kind is 0, LOG_REC_INLINE, LOG_REC_TOKEN or LOG_REC_DUMP
+void Logging::record_begin(LogRecord &rec, uint8_t level, uint8_t kind) {
+  rec.buf[0] = LOG_REC_SYNC;
+  rec.buf[2] = level | kind;
+  rec.pos = 3;
+  if (_ts != LOG_TS_NONE) {
+    rec.buf[2] |= LOG_REC_TS;
+    if (kind == LOG_REC_TOKEN) rec.varint(ts_now());
+    else rec.le(ts_now(), 4);
   }
+  if (_auto_ln) rec.buf[2] |= LOG_REC_LN;
 }
-// Print BINary with leading zeros, 8 char wide
-void Logging::print_u8_to_bin(uint8_t b) {
-    for (uint8_t z = 128; z > 0; z >>= 1) {
-        ((b & z) == z) ? Serial.print('1') : Serial.print('0');
+
+void Logging::record(uint8_t level, const __FlashStringHelper *format, va_list *args) {
+  record(level, reinterpret_cast<PGM_P>(format), true, args);
+}
+
+void Logging::record(uint8_t level, const char *format, va_list *args) {
+  record(level, format, false, args);
+}
+
+// Builds the record of a varargs call: the format is only scanned for the
+// argument types
+void Logging::record(uint8_t level, PGM_P format, bool progmem, va_list *args) {
+  LogRecord rec;
+  if (progmem) {
+    record_begin(rec, level, 0);
+    rec.le((uint16_t)(uintptr_t)format, 2);
+  } else {
+    record_begin(rec, level, LOG_REC_INLINE);
+    rec.str(format);
+    if (rec.pos > LOG_RECORD_SIZE) {
+      rec.buf[LOG_RECORD_SIZE - 1] = 0;
+      rec.pos = LOG_RECORD_SIZE;
+    }
+  }
+  PGM_P p = format;
+  char c = progmem ? pgm_read_byte(p++) : *p++;
+  for (; c != 0 && rec.pos <= LOG_RECORD_SIZE; c = progmem ? pgm_read_byte(p++) : *p++) {
+    if (c != '%') continue;
+    c = progmem ? pgm_read_byte(p++) : *p++;
+    if (c == 0) break;
+    switch (c) {
+      case 's':
+        rec.str(va_arg(*args, const char *));
+        break;
+      case 'd': case 'i': case 'x': case 'X': case 'b': case 'B':
+      case 'c': case 't': case 'T':
+        rec.le((uint32_t)(long)va_arg(*args, int), 4);
+        break;
+      case 'y': case 'Y':
+        rec.le((uint8_t)va_arg(*args, int), 1);
+        break;
+      case 'l':
+        rec.le((uint32_t)va_arg(*args, long), 4);
+        break;
+      case 'u':
+        rec.le(va_arg(*args, uint32_t), 4);
+        break;
+      case 'L':
+        rec.sint64(va_arg(*args, int64_t));
+        break;
+      case 'U': case 'H':
+        rec.uint64(va_arg(*args, uint64_t));
+        break;
+    }
+  }
+  push(rec.buf, rec.end());
+}
+
+// Builds the tokenized record of a varargs call: the argument kinds come
+// from the token, no format is read
+void Logging::record(uint8_t level, LogToken format, va_list *args) {
+  LogRecord rec;
+  record_begin(rec, level, LOG_REC_TOKEN);
+  rec.le(format.token, 2);
+  for (uint64_t sig = format.signature; sig != 0 && rec.pos <= LOG_RECORD_SIZE; sig >>= LOG_ARG_BITS) {
+    switch (sig & ((1 << LOG_ARG_BITS) - 1)) {
+      case LOG_ARG_INT:
+        rec.sint(va_arg(*args, int));
+        break;
+      case LOG_ARG_BYTE:
+        rec.le((uint8_t)va_arg(*args, int), 1);
+        break;
+      case LOG_ARG_LONG:
+        rec.sint(va_arg(*args, long));
+        break;
+      case LOG_ARG_ULONG:
+        rec.uint(va_arg(*args, uint32_t));
+        break;
+      case LOG_ARG_STR:
+        rec.str(va_arg(*args, const char *));
+        break;
+      case LOG_ARG_INT64:
+        rec.sint64(va_arg(*args, int64_t));
+        break;
+      case LOG_ARG_UINT64:
+        rec.uint64(va_arg(*args, uint64_t));
+        break;
+    }
+  }
+  push(rec.buf, rec.end());
+}
+
+#if LOG_BINARY_MODE
+void Logging::push(const uint8_t *rec, uint8_t len) {
+  // the buffer is full: wait for the UART
+  while ((uint8_t)(LOG_BUFFER_SIZE - 1 - ((_head - _tail) & (LOG_BUFFER_SIZE - 1))) < len) {
+    _sink.write(_buf[_tail]);
+    _tail = (_tail + 1) & (LOG_BUFFER_SIZE - 1);
+  }
+  for (uint8_t i = 0; i < len; i++) {
+    _buf[_head] = rec[i];
+    _head = (_head + 1) & (LOG_BUFFER_SIZE - 1);
+  }
+}
+
+void Logging::Drain() {
+  int room = _sink.room();
+  while (room-- > 0 && _tail != _head) {
+    _sink.write(_buf[_tail]);
+    _tail = (_tail + 1) & (LOG_BUFFER_SIZE - 1);
+  }
+}
+
+void Logging::Flush() {
+  while (_tail != _head) {
+    _sink.write(_buf[_tail]);
+    _tail = (_tail + 1) & (LOG_BUFFER_SIZE - 1);
+  }
+}
+#else
+// no buffer: binary() is false, nothing is recorded
+void Logging::push(const uint8_t *, uint8_t) {}
+void Logging::Drain() {}
+void Logging::Flush() {}
+#endif
+
+// One pass over the bytes, into the line or the record
+void Logging::dump(const char *label, const uint8_t *data, uint8_t len, uint8_t format) {
+  int8_t step = 1;
+  if (format & LOG_DUMP_MSB) {
+    data += len - 1;
+    step = -1;
+  }
+  uint8_t view = format & LOG_DUMP_VIEW;
+  if (binary() || view == LOG_DUMP_RAW) {
+    LogRecord rec;
+    record_begin(rec, LOG_LEVEL_INFOS, LOG_REC_DUMP);
+    rec.le(view, 1);
+    rec.str(label);
+    for (; len != 0 && rec.pos <= LOG_RECORD_SIZE; len--, data += step) rec.le(*data, 1);
+    if (binary()) push(rec.buf, rec.end());
+    else _sink.write(rec.buf, rec.end());
+    return;
+  }
+  LogLine line;
+  line_begin(line, LOG_LEVEL_INFOS);
+  line.str(label);
+  line.put(':');
+  line.put(' ');
+  for (uint8_t i = 0; i < len; i++, data += step) {
+    if (view == LOG_DUMP_BIN) {
+      if (i != 0) line.put('-');
+      line.bin8(*data);
+    } else {
+      if (i != 0 && view == LOG_DUMP_BYTES) line.put(' ');
+      line.hex2(*data);
     }
+  }
+  line_end(line);
 }
 
 Logging Log = Logging();
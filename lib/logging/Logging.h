@@ -22,12 +22,235 @@ extern "C" {
 #define LOG_LEVEL_DEBUG 3
 #define LOG_LEVEL_VERBOSE 4
 
-// default loglevel if nothing is set from user
-// #define LOGLEVEL LOG_LEVEL_DEBUG
+// Compile-time loglevel: LOG_ERROR/LOG_INFO/LOG_DEBUG/LOG_VERBOSE calls above it
+// leave no code and no format in flash and do not evaluate their arguments.
+// Define it before including this file, default is everything.
+#ifndef LOGLEVEL
+#define LOGLEVEL LOG_LEVEL_VERBOSE
+#endif
 
 #define CR "\r\n"
+
+// time stamp modes (print_ts of Init, true is LOG_TS_MILLIS): absolute or
+// since the previous message, "0000003009 ms: " / "+0000000412 us: "
+#define LOG_TS_NONE 0
+#define LOG_TS_MILLIS 1
+#define LOG_TS_MICROS 2
+#define LOG_TS_DELTA 4
 #define LOGGING_VERSION 2
 
+// binary mode: build with -DLOG_BINARY_MODE=0 to leave it out, the ring
+// buffer then takes no RAM and Init ignores binary (tokenized needs it)
+#ifndef LOG_BINARY_MODE
+#define LOG_BINARY_MODE 1
+#endif
+
+// binary mode: ring buffer size (power of 2, up to 256) and the largest record
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE 128
+#endif
+#define LOG_RECORD_SIZE 64
+#if LOG_BINARY_MODE
+// the indexes are uint8_t wrapped by a mask, a whole record must fit next
+// to the one free byte that tells full from empty
+static_assert((LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) == 0, "LOG_BUFFER_SIZE must be a power of 2");
+static_assert(LOG_BUFFER_SIZE <= 256, "LOG_BUFFER_SIZE must be at most 256");
+static_assert(LOG_BUFFER_SIZE > LOG_RECORD_SIZE, "LOG_BUFFER_SIZE must be larger than LOG_RECORD_SIZE");
+#endif
+
+// text mode: a line is formatted on the stack and goes to the sink in one
+// write, longer lines in pieces of this size
+#ifndef LOG_LINE_SIZE
+#define LOG_LINE_SIZE 64
+#endif
+// longest %q / %Q text: sign, 20 digits, '.', 9 digits and the '\0'
+#define LOG_FIX_CHARS 32
+#if LOG_LINE_SIZE < LOG_FIX_CHARS
+  #error LOG_LINE_SIZE must hold a fixed point number
+#endif
+
+// binary record: LOG_REC_SYNC, length of the rest, flags (level in the low bits),
+// [time stamp uint32], format address uint16 or inline format text with '\0',
+// arguments in the order of the format (all little endian). The time stamp is
+// the raw millis() / micros() value or delta as in the text, the unit comes
+// from the session record: flags 0 (level 0), then the LOG_TS_ mode byte,
+// sent by Init
+#define LOG_REC_SYNC 0xA5
+#define LOG_REC_LEVEL 0x07
+#define LOG_REC_TS 0x08
+#define LOG_REC_INLINE 0x10
+#define LOG_REC_LN 0x20
+// tokenized record: [time stamp varint], token uint16, arguments as varints
+// (zigzag for the signed ones), %y as one byte, %s as text with '\0'
+#define LOG_REC_TOKEN 0x40
+// dump record: [time stamp uint32], view, label with '\0', the bytes in the
+// order of the view
+#define LOG_REC_DUMP 0x80
+
+// views of Dump, LOG_DUMP_MSB puts the last byte first: the value order of
+// a little endian number
+#define LOG_DUMP_BIN 0   // 00111011-10011010
+#define LOG_DUMP_HEX 1   // 3B9A
+#define LOG_DUMP_BYTES 2 // 3B 9A
+#define LOG_DUMP_RAW 3   // dump record, shown as LOG_DUMP_BYTES by tools/log_decode.py
+#define LOG_DUMP_VIEW 0x0f
+#define LOG_DUMP_MSB 0x10
+
+// Tokenized mode: build with -DLOG_TOKENIZED=1. LOG_FMT("...") then becomes a
+// 16-bit hash of the format computed by the compiler, the format itself stays
+// out of the flash. Messages are always sent as binary records, the
+// dictionary comes from the sources: tools/log_tokens.py src lib > tokens.csv
+#ifndef LOG_TOKENIZED
+#define LOG_TOKENIZED 0
+#endif
+#if LOG_TOKENIZED && !LOG_BINARY_MODE
+  #error LOG_TOKENIZED needs LOG_BINARY_MODE
+#endif
+
+// argument kinds of the tokenized record, 4 bits per argument
+#define LOG_ARG_INT 1
+#define LOG_ARG_BYTE 2
+#define LOG_ARG_LONG 3
+#define LOG_ARG_ULONG 4
+#define LOG_ARG_STR 5
+#define LOG_ARG_FIX32 6 // raw value and q
+#define LOG_ARG_FIX64 7
+#define LOG_ARG_INT64 8
+#define LOG_ARG_UINT64 9
+#define LOG_ARG_BITS 4
+#define LOG_ARG_MAX 10
+
+#include "LogFormat.h"
+
+// only declared: reached from a constant expression it stops the build
+uint64_t log_too_many_arguments();
+
+// FNV-1a of the format (must match tools/log_tokens.py)
+constexpr uint32_t log_fnv1a(const char *s, uint32_t h = 2166136261UL)
+{
+  return (*s == 0) ? h : log_fnv1a(s + 1, (h ^ (uint8_t)*s) * 16777619UL);
+}
+
+constexpr uint16_t log_token(const char *s)
+{
+  return (uint16_t)((log_fnv1a(s) >> 16) ^ (log_fnv1a(s) & 0xffff));
+}
+
+constexpr uint8_t log_arg_kind(char c)
+{
+  return (c == 's') ? LOG_ARG_STR :
+    (c == 'u') ? LOG_ARG_ULONG :
+    (c == 'l') ? LOG_ARG_LONG :
+    (c == 'y' || c == 'Y') ? LOG_ARG_BYTE :
+    (c == 'q') ? LOG_ARG_FIX32 :
+    (c == 'Q') ? LOG_ARG_FIX64 :
+    (c == 'L') ? LOG_ARG_INT64 :
+    (c == 'U' || c == 'H') ? LOG_ARG_UINT64 :
+    (c == 'd' || c == 'i' || c == 'x' || c == 'X' || c == 'b' || c == 'B' ||
+     c == 'c' || c == 't' || c == 'T') ? LOG_ARG_INT : 0;
+}
+
+// argument kinds of the format, the first one in the low bits
+constexpr uint64_t log_signature(const char *s, uint8_t shift = 0)
+{
+  return (*s == 0) ? 0 :
+    (*s != '%') ? log_signature(s + 1, shift) :
+    (s[1] == 0) ? 0 :
+    (log_arg_kind(log_spec(s, 0)) == 0) ? log_signature(s + 2, shift) :
+    (shift >= LOG_ARG_BITS * LOG_ARG_MAX) ? log_too_many_arguments() :
+    ((uint64_t)log_arg_kind(log_spec(s, 0)) << shift) | log_signature(s + log_spec_end(s, 0), shift + LOG_ARG_BITS);
+}
+
+template <uint64_t v> struct LogConst {
+  static constexpr uint64_t value = v;
+};
+
+#include "LogSink.h"
+
+// format replaced by its token and argument kinds
+struct LogToken {
+  uint16_t token;
+  uint64_t signature;
+};
+
+#if LOG_TOKENIZED
+  #define LOG_FMT(s) (LogToken{(uint16_t)LogConst<log_token(s)>::value, LogConst<log_signature(s)>::value})
+#else
+  #define LOG_FMT(s) F(s)
+#endif
+
+// flash copy of the format for the text and binary modes, none when tokenized
+#if LOG_TOKENIZED
+  #define LOG_TEXT(fmt) ((PGM_P)0)
+#else
+  #define LOG_TEXT(fmt) PSTR(fmt)
+#endif
+
+// Log calls filtered by LOGLEVEL at compile time, e.g. LOG_INFO("%u Hz", freq).
+// The format is parsed by the compiler (LogFormat.h): a specifier that does
+// not fit its argument stops the build, the arguments go to typed writers.
+#define LOG_AT(level, fmt, ...) do { \
+    if (level <= LOGLEVEL) { \
+      struct LogFmt { static constexpr const char *str() { return fmt; } }; \
+      Log.write<LogFmt>(level, LOG_TEXT(fmt), ##__VA_ARGS__); \
+    } \
+  } while (0)
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_LEVEL_ERRORS, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) LOG_AT(LOG_LEVEL_INFOS, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define LOG_VERBOSE(fmt, ...) LOG_AT(LOG_LEVEL_VERBOSE, fmt, ##__VA_ARGS__)
+
+// binary record under construction
+struct LogRecord {
+  uint8_t buf[LOG_RECORD_SIZE];
+  uint8_t pos;
+  void le(uint32_t v, uint8_t n);
+  void varint(uint32_t v);
+  void str(const char *s);
+  void sint(long v);
+  void varint64(uint64_t v);
+  void sint64(int64_t v);
+  void uint(uint32_t v);
+  void uint64(uint64_t v);
+  uint8_t end();
+};
+
+// text line under construction, same characters as the Serial.print calls
+struct LogLine {
+  char buf[LOG_LINE_SIZE];
+  uint8_t len;
+  void put(char c);
+  void text_P(PGM_P p, uint8_t n);
+  void str(const char *s);
+  void str_P(PGM_P p);
+  void num(uint32_t v, uint8_t base);
+  void sdec(long v);
+  void u64(uint64_t v);
+  void s64(int64_t v);
+  void hex64(uint64_t v);
+  void dec_fixed(uint32_t v, uint8_t width);
+  void bin8(uint8_t b);
+  void hex2(uint8_t b);
+  void fix32(int32_t raw, uint8_t q, uint8_t digits);
+  void fix64(int64_t raw, uint8_t q, uint8_t digits);
+  void flush();
+};
+
+// A raw value and its q as a %q / %Q argument, e.g. Fp32f<14> x:
+// LOG_INFO("%3q", log_fix32(x.rawVal, 14))
+struct LogFix32 {
+  int32_t rawVal;
+  uint8_t q;
+};
+
+struct LogFix64 {
+  int64_t rawVal;
+  uint8_t q;
+};
+
+inline LogFix32 log_fix32(int32_t raw, uint8_t q) { LogFix32 f = {raw, q}; return f; }
+inline LogFix64 log_fix64(int64_t raw, uint8_t q) { LogFix64 f = {raw, q}; return f; }
+
 /*!
 * Logging is a helper class to output informations over
 * RS232. If you know log4j or log4net, this logging class
@@ -41,6 +264,8 @@ extern "C" {
 * must be start with percent sign (\%)
 *
 * <b>Depending on loglevel, source code is excluded from compile !</b><br>
+* That holds for the LOG_ERROR ... LOG_VERBOSE macros and LOGLEVEL, the
+* level given to Init filters the rest at runtime.<br>
 * <br>
 * <b>Wildcards</b><br>
 * <ul>
@@ -57,7 +282,14 @@ extern "C" {
 * <li><b>\%Y</b>	like %y but combine with <b>0b</b></li>
 * <li><b>\%t</b>	replace and convert boolean value into <b>"t"</b> or <b>"f"</b></li>
 * <li><b>\%T</b>	like %t but convert into <b>"true"</b> or <b>"false"</b></li>
+* <li><b>\%L</b>	replace with an int64_t value</li>
+* <li><b>\%U</b>	replace with an uint64_t value</li>
+* <li><b>\%H</b>	replace and convert a value of up to 64 bits into hex</li>
+* <li><b>\%q</b>	replace with a 32-bit fixed point value (Fp32s, log_fix32)</li>
+* <li><b>\%Q</b>	replace with a 64-bit fixed point value (Fp64s, log_fix64)</li>
 * </ul><br>
+* %q and %Q take a precision digit, "%2q" gives 2 decimals (rounded), without
+* it the decimals of q as Fp32s::qd. They are for the LOG_* macros only.<br>
 * <b>Loglevels</b><br>
 * <table border="0">
 * <tr><td>0</td><td>LOG_LEVEL_NOOUTPUT</td><td>no output </td></tr>
@@ -72,13 +304,43 @@ extern "C" {
 * <tr><td>01 FEB 2012</td><td>initial release</td></tr>
 * <tr><td>06 MAR 2012</td><td>implement a preinstanciate object (like in Wire, ...)</td></tr>
 * <tr><td></td><td>methode init get now loglevel and baud parameter</td></tr>
+* </table>
+* <br>
+* <h1>Text mode</h1><br>
+* A message is formatted into a LogLine on the stack and given to the
+* sink with a single write (in LOG_LINE_SIZE pieces when it is longer).
+* The sink is Serial unless LOG_SINK picks another one (LogSink.h).
+* <br>
+* <h1>Binary mode</h1><br>
+* With binary set in Init every message is stored as a record (format
+* address and raw argument bytes, see LOG_REC_SYNC) in a RAM ring buffer
+* and nothing is formatted on the device. Drain() sends the buffer to
+* Serial as far as it does not block, call it from loop(). Only when the
+* buffer is full a message waits for the UART. tools/log_decode.py turns
+* the stream back into the text of the normal mode. Direct Serial output
+* must not be mixed with it. Built with LOG_BINARY_MODE 0 there is no
+* buffer and every message is text.
+* <br>
+* <h1>Tokenized mode</h1><br>
+* Formats written as LOG_FMT("...") are replaced by a 16-bit token when
+* built with LOG_TOKENIZED (see LOG_REC_TOKEN), only the token and the
+* arguments go on the wire. tools/log_tokens.py makes the dictionary for
+* tools/log_decode.py --tokens.
 */
 class Logging {
 private:
     int _level;
     long _baud;
-    bool _print_ts;
+    uint8_t _ts;
+    uint32_t _ts_last;
     bool _auto_ln;
+    bool _binary;
+#if LOG_BINARY_MODE
+    uint8_t _buf[LOG_BUFFER_SIZE];
+    uint8_t _head;
+    uint8_t _tail;
+#endif
+    LogSinkType _sink;
 public:
     /*!
 	 * default Constructor
@@ -86,12 +348,76 @@ public:
     Logging(){} ;
 
     /**
-	* Initializing, must be called as first.
-	* \param void
+	* Initializing, must be called as first. Records still buffered from
+	* an earlier Init are sent before the sink starts again.
+	* \param level LOG_LEVEL_NOOUTPUT ... LOG_LEVEL_VERBOSE
+	* \param baud Serial speed
+	* \param print_ts time stamp mode: LOG_TS_NONE, LOG_TS_MILLIS or
+	* LOG_TS_MICROS, | LOG_TS_DELTA for the time since the previous message
+	* \param auto_ln CR LF after each message
+	* \param binary binary records instead of text
 	* \return void
 	*
 	*/
-    void Init(int level, long baud, bool print_ts, bool auto_ln);
+    void Init(int level, long baud, uint8_t print_ts, bool auto_ln, bool binary = false);
+
+    /**
+	* Changes the runtime level without Init: no Serial.begin, the
+	* buffered records stay.
+	* \param level LOG_LEVEL_NOOUTPUT ... LOG_LEVEL_VERBOSE
+	* \return void
+	*/
+    void SetLevel(int level);
+
+    /**
+	* Changes the output mode without Init, the records buffered so far
+	* are sent first. Binary mode starts with a new session record.
+	* \param print_ts time stamp mode as for Init
+	* \param auto_ln CR LF after each message
+	* \param binary binary records instead of text
+	* \return void
+	*/
+    void SetMode(uint8_t print_ts, bool auto_ln, bool binary = false);
+
+    /**
+	* Binary mode: sends buffered records to Serial as long as
+	* Serial.write does not block, call it when idle.
+	* \param void
+	* \return void
+	*/
+    void Drain();
+
+    /**
+	* Binary mode: sends all buffered records, waits for the UART.
+	* \param void
+	* \return void
+	*/
+    void Flush();
+
+    /**
+	* The sink chosen by LOG_SINK (LogSink.h), e.g. the captured
+	* bytes of LOG_SINK_RAM.
+	* \param void
+	* \return the sink
+	*/
+    LogSinkType &Sink() { return _sink; }
+
+    /**
+	* Output of len bytes as one info line "label: ..." in the view of
+	* format (LOG_DUMP_BIN ... LOG_DUMP_RAW, | LOG_DUMP_MSB). In the binary
+	* modes and with LOG_DUMP_RAW the bytes go out unformatted as a dump
+	* record (in the text mode too), tools/log_decode.py shows them.
+	* \param label text before the bytes
+	* \param data the bytes
+	* \param len their number
+	* \param format view and byte order
+	* \return void
+	*/
+    void Dump(const char *label, const void *data, uint8_t len, uint8_t format){
+      if (LOG_LEVEL_INFOS <= LOGLEVEL && LOG_LEVEL_INFOS <= _level) {
+        dump(label, (const uint8_t *)data, len, format);
+      }
+    }
 
     /**
 	* Output an error message. Output message contains
@@ -103,13 +429,18 @@ public:
 	* \return void
 	*/
   template <class T> void Error(T msg, ...){
-    if (LOG_LEVEL_ERRORS <= _level) {
-      print (F("ERROR: "),0);
+    if (LOG_LEVEL_ERRORS <= LOGLEVEL && LOG_LEVEL_ERRORS <= _level) {
       va_list args;
       va_start(args, msg);
-      print_ts();
-      print(msg,args);
-      if(_auto_ln) Serial.println();
+      if (binary()) {
+        record(LOG_LEVEL_ERRORS, msg, &args);
+      } else {
+        LogLine line;
+        line_begin(line, LOG_LEVEL_ERRORS);
+        print(line,msg,&args);
+        line_end(line);
+      }
+      va_end(args);
     }
   }
 
@@ -125,12 +456,18 @@ public:
 	*/
 
   template <class T> void Info(T msg, ...){
-    if (LOG_LEVEL_INFOS <= _level) {
+    if (LOG_LEVEL_INFOS <= LOGLEVEL && LOG_LEVEL_INFOS <= _level) {
       va_list args;
       va_start(args, msg);
-      print_ts();
-      print(msg,args);
-      if(_auto_ln) Serial.println();
+      if (binary()) {
+        record(LOG_LEVEL_INFOS, msg, &args);
+      } else {
+        LogLine line;
+        line_begin(line, LOG_LEVEL_INFOS);
+        print(line,msg,&args);
+        line_end(line);
+      }
+      va_end(args);
     }
   }
 
@@ -146,12 +483,18 @@ public:
 
 
   template <class T> void Debug(T msg, ...){
-    if (LOG_LEVEL_DEBUG <= _level) {
+    if (LOG_LEVEL_DEBUG <= LOGLEVEL && LOG_LEVEL_DEBUG <= _level) {
       va_list args;
       va_start(args, msg);
-      print_ts();
-      print(msg,args);
-      if(_auto_ln) Serial.println();
+      if (binary()) {
+        record(LOG_LEVEL_DEBUG, msg, &args);
+      } else {
+        LogLine line;
+        line_begin(line, LOG_LEVEL_DEBUG);
+        print(line,msg,&args);
+        line_end(line);
+      }
+      va_end(args);
     }
   }
 
@@ -167,22 +510,144 @@ public:
 	*/
 
   template <class T> void Verbose(T msg, ...){
-    if (LOG_LEVEL_VERBOSE <= _level) {
+    if (LOG_LEVEL_VERBOSE <= LOGLEVEL && LOG_LEVEL_VERBOSE <= _level) {
       va_list args;
       va_start(args, msg);
-      print_ts();
-      print(msg,args);
-      if(_auto_ln) Serial.println();
+      if (binary()) {
+        record(LOG_LEVEL_VERBOSE, msg, &args);
+      } else {
+        LogLine line;
+        line_begin(line, LOG_LEVEL_VERBOSE);
+        print(line,msg,&args);
+        line_end(line);
+      }
+      va_end(args);
     }
   }
 
 
+    /**
+	* Typed front end of the LOG_ERROR ... LOG_VERBOSE macros: F::str() is
+	* the format, checked against the argument types at compile time, text
+	* its copy in flash. No format scan and no va_list at runtime.
+	* \param level LOG_LEVEL_ERRORS ... LOG_LEVEL_VERBOSE
+	* \param text flash copy of the format (0 when tokenized)
+	* \param args the arguments
+	* \return void
+	*/
+  template <class F, class... A> void write(uint8_t level, PGM_P text, A... args){
+    static_assert(log_length(F::str()) < 255, "log format is too long");
+    static_assert(LogArgs<A...>::check(F::str(), 0),
+      "log format specifiers do not match the argument types");
+    if (level > _level) return;
+    if (binary()) {
+      LogRecord rec;
+      if (LOG_TOKENIZED) {
+        record_begin(rec, level, LOG_REC_TOKEN);
+        rec.le(LogConst<log_token(F::str())>::value, 2);
+      } else {
+        record_begin(rec, level, 0);
+        rec.le((uint16_t)(uintptr_t)text, 2);
+      }
+      put<F, 0>(rec, args...);
+      push(rec.buf, rec.end());
+    } else {
+      LogLine line;
+      line_begin(line, level);
+      emit<F, 0>(line, text, args...);
+      line_end(line);
+    }
+  }
+
 private:
-    void print(const char *format, va_list args);
-    void print(const __FlashStringHelper *format, va_list args);
-    void printFormat(const char format, va_list *args);
-    void print_ts();
-    void print_u8_to_bin(uint8_t b);
+    // records instead of text, a constant false without LOG_BINARY_MODE
+    bool binary() const { return LOG_TOKENIZED || (LOG_BINARY_MODE && _binary); }
+
+    // text of the typed front end: literal up to the next '%', then the
+    // specifier ("%%" or the next argument), all positions are constants
+    template <class F, uint8_t pos> void emit(LogLine &line, PGM_P text){
+      line.text_P(text + pos, log_next_pct(F::str(), pos) - pos);
+      emit_end<F, log_next_pct(F::str(), pos)>(line, text, LogBool<F::str()[log_next_pct(F::str(), pos)] == 0>());
+    }
+    template <class F, uint8_t pct> void emit_end(LogLine &, PGM_P, LogBool<true>){}
+    template <class F, uint8_t pct> void emit_end(LogLine &line, PGM_P text, LogBool<false>){
+      line.put('%');
+      emit<F, pct + 2>(line, text);
+    }
+    template <class F, uint8_t pos, class T, class... R> void emit(LogLine &line, PGM_P text, T a, R... rest){
+      line.text_P(text + pos, log_next_pct(F::str(), pos) - pos);
+      emit_arg<F, log_next_pct(F::str(), pos)>(line, text,
+        LogBool<F::str()[log_next_pct(F::str(), pos) + 1] == '%'>(), a, rest...);
+    }
+    template <class F, uint8_t pct, class T, class... R> void emit_arg(LogLine &line, PGM_P text, LogBool<true>, T a, R... rest){
+      line.put('%');
+      emit<F, pct + 2>(line, text, a, rest...);
+    }
+    template <class F, uint8_t pct, class T, class... R> void emit_arg(LogLine &line, PGM_P text, LogBool<false>, T a, R... rest){
+      print_arg(line, LogSpec<log_spec(F::str(), pct), log_prec(F::str(), pct)>(), a);
+      emit<F, log_spec_end(F::str(), pct)>(line, text, rest...);
+    }
+
+    // typed writers, the same text as printFormat
+    template <class T> void print_arg(LogLine &line, LogSpec<'d'>, T v){ line.sdec((int)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'i'>, T v){ line.sdec((int)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'x'>, T v){ line.num((long)(int)v, HEX); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'X'>, T v){ line.str_P(PSTR("0x")); line.num((long)(int)v, HEX); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'b'>, T v){ line.num((long)(int)v, BIN); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'B'>, T v){ line.str_P(PSTR("0b")); line.num((long)(int)v, BIN); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'y'>, T v){ line.bin8((uint8_t)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'Y'>, T v){ line.str_P(PSTR("0b")); line.bin8((uint8_t)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'l'>, T v){ line.sdec((long)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'u'>, T v){ line.num((uint32_t)v, DEC); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'L'>, T v){ line.s64((int64_t)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'U'>, T v){ line.u64((uint64_t)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'H'>, T v){ line.hex64((uint64_t)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'c'>, T v){ line.sdec((int)v); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'t'>, T v){ line.put(v ? 'T' : 'F'); }
+    template <class T> void print_arg(LogLine &line, LogSpec<'T'>, T v){ line.str_P(v ? PSTR("true") : PSTR("false")); }
+    void print_arg(LogLine &line, LogSpec<'s'>, const char *v){ line.str(v); }
+    template <uint8_t prec, class T> void print_arg(LogLine &line, LogSpec<'q', prec>, T v){ line.fix32(v.rawVal, v.q, prec); }
+    template <uint8_t prec, class T> void print_arg(LogLine &line, LogSpec<'Q', prec>, T v){ line.fix64(v.rawVal, v.q, prec); }
+
+    // binary record of the typed front end, the same bytes as record()
+    template <class F, uint8_t pos> void put(LogRecord &){}
+    template <class F, uint8_t pos, class T, class... R> void put(LogRecord &rec, T a, R... rest){
+      put_arg<F, log_next_pct(F::str(), pos)>(rec,
+        LogBool<F::str()[log_next_pct(F::str(), pos) + 1] == '%'>(), a, rest...);
+    }
+    template <class F, uint8_t pct, class T, class... R> void put_arg(LogRecord &rec, LogBool<true>, T a, R... rest){
+      put<F, pct + 2>(rec, a, rest...);
+    }
+    template <class F, uint8_t pct, class T, class... R> void put_arg(LogRecord &rec, LogBool<false>, T a, R... rest){
+      put_kind(rec, LogConst<log_arg_kind(log_spec(F::str(), pct))>(), a);
+      put<F, log_spec_end(F::str(), pct)>(rec, rest...);
+    }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_INT>, T v){ rec.sint((int)v); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_BYTE>, T v){ rec.le((uint8_t)v, 1); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_LONG>, T v){ rec.sint((long)v); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_ULONG>, T v){ rec.uint((uint32_t)v); }
+    void put_kind(LogRecord &rec, LogConst<LOG_ARG_STR>, const char *v){ rec.str(v); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_INT64>, T v){ rec.sint64((int64_t)v); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_UINT64>, T v){ rec.uint64((uint64_t)v); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_FIX32>, T v){ rec.sint(v.rawVal); rec.le(v.q, 1); }
+    template <class T> void put_kind(LogRecord &rec, LogConst<LOG_ARG_FIX64>, T v){ rec.sint64(v.rawVal); rec.le(v.q, 1); }
+
+    void line_begin(LogLine &line, uint8_t level);
+    void line_end(LogLine &line);
+    void print(LogLine &line, const char *format, va_list *args);
+    void print(LogLine &line, const __FlashStringHelper *format, va_list *args);
+    void printFormat(LogLine &line, const char format, va_list *args);
+    void print_ts(LogLine &line);
+    uint32_t ts_now();
+    void record(uint8_t level, const char *format, va_list *args);
+    void record(uint8_t level, const __FlashStringHelper *format, va_list *args);
+    void record(uint8_t level, PGM_P format, bool progmem, va_list *args);
+    void record(uint8_t level, LogToken format, va_list *args);
+    // tokens are always recorded, there is no text to print
+    void print(LogLine &, LogToken, va_list *) {}
+    void record_begin(LogRecord &rec, uint8_t level, uint8_t kind);
+    void push(const uint8_t *rec, uint8_t len);
+    void dump(const char *label, const uint8_t *data, uint8_t len, uint8_t format);
 };
 
 extern Logging Log;
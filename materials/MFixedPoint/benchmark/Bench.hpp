@@ -0,0 +1,313 @@
+//!
+//! @file 				Bench.hpp
+//! @author 			AndrewBiz
+//! @created			2026-10-16
+//! @brief 				Micro-benchmark harness for the fixed-point operations.
+//! @details
+//!		A benchmark is a function that runs one operation n times. It is timed
+//!		as a whole (one sample): n is doubled until a sample takes min_sample_ns,
+//!		then samples are run for warmup_ns and thrown away, then the kept
+//!		samples give the time per operation (median, p99, min, max, mean, stddev).
+//!
+//!		The loops keep the compiler from folding or hoisting the operation:
+//!		Opaque() makes the compiler forget what it knows about a value (no
+//!		instruction is emitted for values in registers), Sink() makes it keep a
+//!		result it would otherwise drop.
+//!		- latency: x = op(x, y) chained, each operation waits for the one before
+//!		- throughput: op(a[i], b[i]) on independent inputs, the CPU can overlap them
+//!
+//!		On Linux the kept samples are also counted with perf_event_open (user
+//!		space only): cycles, instructions, branches and branch misses per
+//!		operation, and IPC. The counts include the loop ("loop" case). Without
+//!		hardware counters (VMs, perf_event_paranoid > 2) only times are given.
+
+#ifndef __cplusplus
+	#error Please build with C++ compiler
+#endif
+
+#ifndef MFIXED_POINT_BENCH_H
+#define MFIXED_POINT_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+	#include <errno.h>
+	#include <unistd.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
+
+namespace Bench
+{
+	//! @brief		The compiler must assume v changed (v stays in its register).
+	inline void Opaque(int32_t &v) { asm volatile("" : "+r"(v)); }
+	inline void Opaque(int64_t &v) { asm volatile("" : "+r"(v)); }
+	inline void Opaque(uint8_t &v) { asm volatile("" : "+r"(v)); }
+	template <class T> inline void Opaque(T &v) { asm volatile("" : "+m"(v)); }
+
+	//! @brief		The compiler must compute v (and can not drop the operation).
+	template <class T> inline void Sink(const T &v) { asm volatile("" : : "r,m"(v)); }
+
+	//! @brief		Inputs of a benchmark, indexed with i & (INPUTS - 1). Long enough
+	//!				that a random pattern in them is not learned by the branch predictor.
+	static const uint32_t INPUTS = 1024;
+
+	//! @brief		Inputs of a benchmark, data names the set (e.g. "q16", "mixed q").
+	template <class T> struct Inputs {
+		T v[INPUTS];
+		const char *data;
+		Inputs() : data("-") {}
+	};
+
+	struct Case {
+		std::string type;
+		std::string op;
+		std::string data;
+		const char *variant;
+		std::function<void(uint64_t)> run;
+	};
+
+	struct Result {
+		uint64_t iterations;	// operations per sample
+		double median_ns;		// all times per operation
+		double p99_ns;
+		double min_ns;
+		double max_ns;
+		double mean_ns;
+		double stddev_ns;
+		bool counted;			// counters below are valid
+		double cycles;			// all counts per operation
+		double instructions;
+		double branches;
+		double branch_misses;
+	};
+
+	struct Options {
+		uint32_t samples;
+		uint64_t min_sample_ns;
+		uint64_t warmup_ns;
+		Options() : samples(51), min_sample_ns(50000), warmup_ns(20000000) {}
+	};
+
+	//! @brief		Group of user space hardware counters of this thread.
+	class Counters
+	{
+	public:
+		enum { CYCLES, INSTRUCTIONS, BRANCHES, BRANCH_MISSES, COUNT };
+
+		Counters() : error(0)
+		{
+			for (int i = 0; i < COUNT; i++)
+				fd[i] = -1;
+			#if defined(__linux__)
+			static const uint64_t config[COUNT] = {
+				PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_BRANCH_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES
+			};
+			for (int i = 0; i < COUNT; i++) {
+				struct perf_event_attr attr;
+				memset(&attr, 0, sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = config[i];
+				attr.disabled = (i == 0);	// the group starts with its leader
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+				attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+					PERF_FORMAT_TOTAL_TIME_RUNNING;
+				fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i ? fd[0] : -1, 0);
+				if (fd[i] < 0) {
+					error = errno;
+					Close();
+					return;
+				}
+			}
+			#else
+			error = ENOSYS;
+			#endif
+		}
+
+		~Counters() { Close(); }
+
+		bool Ok() const { return fd[0] >= 0; }
+
+		//! @brief		Why the counters could not be opened.
+		const char *Error() const { return strerror(error); }
+
+		void Start()
+		{
+			#if defined(__linux__)
+			ioctl(fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			#endif
+		}
+
+		//! @brief		Stops the counters and adds the counts since Start() to sum.
+		//! @returns	false if the group was not scheduled on the PMU.
+		bool Stop(double sum[COUNT])
+		{
+			#if defined(__linux__)
+			ioctl(fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+			// nr, time_enabled, time_running, values[nr]
+			uint64_t buf[3 + COUNT];
+			if (read(fd[0], buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf[0] != COUNT || buf[2] == 0)
+				return false;
+			// shared with other users of the PMU: scale up to the enabled time
+			double scale = (double)buf[1] / (double)buf[2];
+			for (int i = 0; i < COUNT; i++)
+				sum[i] += (double)buf[3 + i] * scale;
+			return true;
+			#else
+			(void)sum;
+			return false;
+			#endif
+		}
+
+	private:
+		int fd[COUNT];
+		int error;
+
+		void Close()
+		{
+			for (int i = COUNT - 1; i >= 0; i--) {
+				#if defined(__linux__)
+				if (fd[i] >= 0)
+					close(fd[i]);
+				#endif
+				fd[i] = -1;
+			}
+		}
+
+		Counters(const Counters &);
+		Counters &operator=(const Counters &);
+	};
+
+	inline std::vector<Case> &Cases()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	inline uint64_t NowNs()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	inline uint64_t TimeNs(const Case &c, uint64_t n)
+	{
+		uint64_t t0 = NowNs();
+		c.run(n);
+		return NowNs() - t0;
+	}
+
+	//! @brief		Times c, counters (may be 0) count the kept samples.
+	inline Result Run(const Case &c, const Options &opt, Counters *counters)
+	{
+		Result r;
+		uint64_t n = 1;
+		while (TimeNs(c, n) < opt.min_sample_ns && n < ((uint64_t)1 << 40))
+			n *= 2;
+		for (uint64_t t0 = NowNs(); NowNs() - t0 < opt.warmup_ns;)
+			TimeNs(c, n);
+		std::vector<double> ns(opt.samples);
+		double sum_count[Counters::COUNT] = {0};
+		r.counted = counters != 0;
+		for (uint32_t s = 0; s < opt.samples; s++) {
+			if (counters)
+				counters->Start();
+			ns[s] = (double)TimeNs(c, n) / (double)n;
+			if (counters && !counters->Stop(sum_count))
+				r.counted = false;
+		}
+		double ops = (double)n * opt.samples;
+		r.cycles = sum_count[Counters::CYCLES] / ops;
+		r.instructions = sum_count[Counters::INSTRUCTIONS] / ops;
+		r.branches = sum_count[Counters::BRANCHES] / ops;
+		r.branch_misses = sum_count[Counters::BRANCH_MISSES] / ops;
+		std::sort(ns.begin(), ns.end());
+		double sum = 0, sum2 = 0;
+		for (uint32_t s = 0; s < opt.samples; s++) {
+			sum += ns[s];
+			sum2 += ns[s] * ns[s];
+		}
+		r.iterations = n;
+		r.median_ns = (opt.samples % 2) ? ns[opt.samples / 2] : (ns[opt.samples / 2 - 1] + ns[opt.samples / 2]) / 2;
+		// nearest rank
+		r.p99_ns = ns[(uint32_t)ceil(0.99 * opt.samples) - 1];
+		r.min_ns = ns[0];
+		r.max_ns = ns[opt.samples - 1];
+		r.mean_ns = sum / opt.samples;
+		r.stddev_ns = sqrt(std::max(0.0, sum2 / opt.samples - r.mean_ns * r.mean_ns));
+		return r;
+	}
+
+	//! @brief		Runs the cases whose "type/op" contains filter, prints a
+	//!				table or JSON to stdout.
+	inline void RunAll(const Options &opt, const char *filter, bool json, bool count)
+	{
+		Counters counters;
+		Counters *pc = 0;
+		if (count && counters.Ok())
+			pc = &counters;
+		else if (count)
+			fprintf(stderr, "no hardware counters (%s), times only\n", counters.Error());
+		bool first = true;
+		if (json)
+			printf("{\n  \"context\": {\"samples\": %u, \"min_sample_ns\": %llu, \"warmup_ns\": %llu, "
+				"\"clock\": \"steady_clock\", \"counters\": %s},\n  \"benchmarks\": [",
+				opt.samples, (unsigned long long)opt.min_sample_ns, (unsigned long long)opt.warmup_ns,
+				pc ? "true" : "false");
+		else
+			printf("%-12s %-14s %-8s %-10s %10s %10s %10s %8s %12s %8s %8s %8s %8s %6s\n",
+				"type", "op", "data", "variant", "median ns", "p99 ns", "min ns", "cv %", "ops/sample",
+				"cycles", "instr", "branch", "b-miss", "IPC");
+		for (size_t i = 0; i < Cases().size(); i++) {
+			const Case &c = Cases()[i];
+			if (filter && (c.type + "/" + c.op).find(filter) == std::string::npos)
+				continue;
+			Result r = Run(c, opt, pc);
+			double ipc = r.cycles > 0 ? r.instructions / r.cycles : 0;
+			if (json) {
+				printf("%s\n    {\"type\": \"%s\", \"op\": \"%s\", \"data\": \"%s\", \"variant\": \"%s\", "
+					"\"iterations\": %llu, \"samples\": %u, \"median_ns\": %.4f, \"p99_ns\": %.4f, "
+					"\"min_ns\": %.4f, \"max_ns\": %.4f, \"mean_ns\": %.4f, \"stddev_ns\": %.4f",
+					first ? "" : ",", c.type.c_str(), c.op.c_str(), c.data.c_str(), c.variant,
+					(unsigned long long)r.iterations, opt.samples, r.median_ns, r.p99_ns, r.min_ns,
+					r.max_ns, r.mean_ns, r.stddev_ns);
+				if (r.counted)
+					printf(", \"cycles\": %.3f, \"instructions\": %.3f, \"branches\": %.3f, "
+						"\"branch_misses\": %.4f, \"ipc\": %.3f",
+						r.cycles, r.instructions, r.branches, r.branch_misses, ipc);
+				printf("}");
+			} else {
+				printf("%-12s %-14s %-8s %-10s %10.3f %10.3f %10.3f %8.2f %12llu",
+					c.type.c_str(), c.op.c_str(), c.data.c_str(), c.variant, r.median_ns, r.p99_ns, r.min_ns,
+					r.mean_ns > 0 ? 100.0 * r.stddev_ns / r.mean_ns : 0.0, (unsigned long long)r.iterations);
+				if (r.counted)
+					printf(" %8.2f %8.2f %8.2f %8.3f %6.2f\n",
+						r.cycles, r.instructions, r.branches, r.branch_misses, ipc);
+				else
+					printf(" %8s %8s %8s %8s %6s\n", "-", "-", "-", "-", "-");
+			}
+			fflush(stdout);
+			first = false;
+		}
+		if (json)
+			printf("\n  ]\n}\n");
+	}
+
+} // namespace Bench
+
+#endif // #ifndef MFIXED_POINT_BENCH_H
+
+// EOF
@@ -1,201 +1,304 @@
 //!
 //! @file 				main.cpp
 //! @author 			Geoffrey Hunter <gbmhunter@gmail.com> (www.mbedded.ninja)
-//! @edited 			n/a
+//! @edited 			AndrewBiz
 //! @created			2013-05-30
-//! @last-modified		2014-09-15
+//! @last-modified		2026-10-16
 //! @brief 				Has the entry point for the benchmark program.
 //! @details
-//!		See README.rst in root dir for more info.
+//!		Every operator and conversion of Fp32s, Fp32f<16>, Fp64f<32> and Fp64s, in
+//!		latency and throughput variants (see Bench.hpp), "loop" is the harness alone.
+//!		Fp32s and Fp64s run twice, with one Q for all operands and with a random Q
+//!		per operand, the second shows the cost of their q == r.q / q > r.q branches
+//!		(branch misses with the hardware counters).
+//!
+//!		FpBenchmark.out [--json] [--filter TEXT] [--samples N] [--min-sample-us N] [--warmup-ms N]
+//!			[--no-counters]
+//!
+//!		--filter runs the benchmarks whose "type/op" contains TEXT (e.g. Fp32s/ or /+=),
+//!		--json prints the results as JSON instead of a table, --no-counters does not
+//!		read the hardware counters.
 
 //==== SYSTEM LIBRARIES ====//
-#include <sys/time.h>
-#include <sys/resource.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 //==== USER SOURCE ====//
 #include "../api/MFixedPointApi.hpp"
+#include "Bench.hpp"
 
 using namespace Fp;
 
-#define NUM_TESTS	10000
+typedef Fp32f<16> Fp32f16;
+typedef Fp64f<32> Fp64f32;
 
-#define ADDITION_AVG 0.010
-#define SUBTRACTION_AVG 0.010
-
-typedef struct tag_time_measure
+namespace Bench
 {
-  struct timeval startTimeVal;
-  struct timeval stopTimeVal;
+	// all members, so the q branches of Fp32s and Fp64s are not folded either
+	inline void Opaque(Fp32s &x) { Opaque(x.rawVal); Opaque(x.q); }
+	inline void Opaque(Fp64s &x) { Opaque(x.rawVal); Opaque(x.q); }
+	template <uint8_t q> inline void Opaque(Fp32f<q> &x) { Opaque(x.rawVal); }
+	template <uint8_t p> inline void Opaque(Fp64f<p> &x) { Opaque(x.rawVal); }
+	inline void Sink(const Fp32s &x) { Sink(x.rawVal); Sink(x.q); }
+	inline void Sink(const Fp64s &x) { Sink(x.rawVal); Sink(x.q); }
+	template <uint8_t q> inline void Sink(const Fp32f<q> &x) { Sink(x.rawVal); }
+	template <uint8_t p> inline void Sink(const Fp64f<p> &x) { Sink(x.rawVal); }
 
-  struct rusage startTimeUsage;
-  struct rusage stopTimeUsage;
-} time_measure;
+	// Latency chains: the next input depends on the result (plus an add for
+	// results that are not of the input type)
+	template <class T> inline void Feed(T &x, const T &r) { x = r; }
+	template <class T> inline void Feed(T &x, bool r) { x.rawVal += r; }
+	template <class T> inline void Feed(T &x, uint8_t r) { x.rawVal += r; }
+	template <class T> inline void Feed(T &x, int16_t r) { x.rawVal += r; }
+	template <class T> inline void Feed(T &x, int32_t r) { x.rawVal += r; }
+	template <class T> inline void Feed(T &x, int64_t r) { x.rawVal += r; }
+	template <class T> inline void Feed(T &x, float r) { int32_t b; memcpy(&b, &r, sizeof(b)); x.rawVal += b; }
+	template <class T> inline void Feed(T &x, double r) { int64_t b; memcpy(&b, &r, sizeof(b)); x.rawVal += b; }
 
-time_measure* StartTimeMeasuring()
-{
-  time_measure* tu = (time_measure*)malloc(sizeof(time_measure));
-  if(!tu)
-    exit(1);
+	//! @brief		Registers op(T, U) as latency (x = op(x, b[i])) and throughput
+	//!				(op(a[i], b[i])) benchmark.
+	template <class T, class U, class F>
+	void AddBinary(const char *type, const char *op, const Inputs<T> &a, const Inputs<U> &b, F f)
+	{
+		Case lat = {type, op, a.data, "latency", [=](uint64_t n) {
+			T x = a.v[0];
+			for (uint64_t i = 0; i < n; i++) {
+				U y = b.v[i & (INPUTS - 1)];
+				Opaque(y);
+				Feed(x, f(x, y));
+				Opaque(x);
+			}
+			Sink(x);
+		}};
+		Case thr = {type, op, a.data, "throughput", [=](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				T x = a.v[i & (INPUTS - 1)];
+				U y = b.v[i & (INPUTS - 1)];
+				Opaque(x);
+				Opaque(y);
+				Sink(f(x, y));
+			}
+		}};
+		Cases().push_back(lat);
+		Cases().push_back(thr);
+	}
+
+	//! @brief		Registers op(T) as latency and throughput benchmark.
+	template <class T, class F>
+	void AddUnary(const char *type, const char *op, const Inputs<T> &a, F f)
+	{
+		Case lat = {type, op, a.data, "latency", [=](uint64_t n) {
+			T x = a.v[0];
+			for (uint64_t i = 0; i < n; i++) {
+				Feed(x, f(x));
+				Opaque(x);
+			}
+			Sink(x);
+		}};
+		Case thr = {type, op, a.data, "throughput", [=](uint64_t n) {
+			for (uint64_t i = 0; i < n; i++) {
+				T x = a.v[i & (INPUTS - 1)];
+				Opaque(x);
+				Sink(f(x));
+			}
+		}};
+		Cases().push_back(lat);
+		Cases().push_back(thr);
+	}
+} // namespace Bench
 
-  getrusage(RUSAGE_SELF, &tu->startTimeUsage);
-  gettimeofday(&tu->startTimeVal,0);
+using namespace Bench;
 
-  return tu;
+// Operands: a spread over +-100, b alternating about 1.25 and 0.8, so that
+// chains of * and / stay in range, and never 0 (for / and %), repeated over
+// the INPUTS
+static const uint32_t VALS = 16;
+static const double aVals[VALS] = {
+	5.6, -8.9, 97.25, -0.375, 12.0625, -45.5, 0.0078125, 63.3,
+	-77.7, 1.5, -2.25, 33.125, -19.8, 88.0, -0.5, 7.75
+};
+static const double bVals[VALS] = {
+	1.25, 0.8, 1.3, 0.77, 1.2, 0.83, 1.1, 0.91,
+	1.25, 0.8, 1.3, 0.77, 1.2, 0.83, 1.1, 0.91
+};
+static const int32_t iVals[VALS] = {3, -2, 5, 1, -7, 2, 4, -1, 6, -3, 2, 1, -5, 3, 2, 1};
+
+// decimal text for FromChars, picked by the low bits of the input
+static const char *texts[8] = {
+	"5.6", "-8.9", "97.25", "-0.375", "12.0625", "-45.5", "0.0078125", "63.3"
+};
+
+//! @brief		Inputs make(vals[i % VALS], i), named data.
+template <class T, class Make> static Inputs<T> MakeInputs(const double *vals, const char *data, Make make)
+{
+	Inputs<T> in;
+	for (uint32_t i = 0; i < INPUTS; i++)
+		in.v[i] = make(vals[i % VALS], i);
+	in.data = data;
+	return in;
 }
 
-void StopTimeMeasuring(time_measure * tu)
+//! @brief		Q of input i of a mixed set: q0, q1 or q2, picked at random (but the
+//!				same every run), so the q branches of Fp32s and Fp64s can not be
+//!				predicted. The b inputs use i + INPUTS.
+static uint8_t MixedQ(uint32_t i, uint8_t q0, uint8_t q1, uint8_t q2)
 {
-  getrusage(RUSAGE_SELF, &tu->stopTimeUsage);
-  gettimeofday(&tu->stopTimeVal,0);
+	const uint8_t q[3] = {q0, q1, q2};
+	return q[(((i + 1) * 2654435761u) >> 16) % 3];
 }
 
-void PrintMeasuredTime(time_measure * tu)
+// Operators and comparisons shared by all types
+template <class T> static void AddArithmetic(const char *type, const Inputs<T> &a, const Inputs<T> &b)
 {
-	struct timeval elapsedVal;
-	struct timeval userVal;
-	struct timeval systemVal;
+	AddBinary(type, "+", a, b, [](T x, T y) { return x + y; });
+	AddBinary(type, "-", a, b, [](T x, T y) { return x - y; });
+	AddBinary(type, "*", a, b, [](T x, T y) { return x * y; });
+	AddBinary(type, "/", a, b, [](T x, T y) { return x / y; });
+	AddBinary(type, "%", a, b, [](T x, T y) { return x % y; });
+	AddBinary(type, "+=", a, b, [](T x, T y) { x += y; return x; });
+	AddBinary(type, "-=", a, b, [](T x, T y) { x -= y; return x; });
+	AddBinary(type, "*=", a, b, [](T x, T y) { x *= y; return x; });
+	AddBinary(type, "/=", a, b, [](T x, T y) { x /= y; return x; });
+	AddBinary(type, "%=", a, b, [](T x, T y) { x %= y; return x; });
+	AddBinary(type, "==", a, b, [](T x, T y) { return x == y; });
+	AddBinary(type, "!=", a, b, [](T x, T y) { return x != y; });
+	AddBinary(type, "<", a, b, [](T x, T y) { return x < y; });
+	AddBinary(type, ">", a, b, [](T x, T y) { return x > y; });
+	AddBinary(type, "<=", a, b, [](T x, T y) { return x <= y; });
+	AddBinary(type, ">=", a, b, [](T x, T y) { return x >= y; });
+	AddUnary(type, "(float)", a, [](T x) { return (float)x; });
+	AddUnary(type, "(double)", a, [](T x) { return (double)x; });
+}
 
-	double elapsed_millis = 0.0f;
-	double user_millis = 0.0f;
-	double system_millis = 0.0f;
+static void AddLoop()
+{
+	Inputs<Fp32s> a = MakeInputs<Fp32s>(aVals, "-", [](double d, uint32_t) { return Fp32s(d, 16); });
+	AddBinary("loop", "-", a, a, [](Fp32s x, Fp32s) { return x; });
+}
 
-	timersub(&tu->stopTimeVal, &tu->startTimeVal, &elapsedVal);
-	timersub(&tu->stopTimeUsage.ru_utime, &tu->startTimeUsage.ru_utime, &userVal);
-	timersub(&tu->stopTimeUsage.ru_stime, &tu->startTimeUsage.ru_stime, &systemVal);
+static void AddFp32s()
+{
+	Inputs<Fp32s> a = MakeInputs<Fp32s>(aVals, "q16", [](double d, uint32_t) { return Fp32s(d, 16); });
+	Inputs<Fp32s> b = MakeInputs<Fp32s>(bVals, "q16", [](double d, uint32_t) { return Fp32s(d, 16); });
+	AddArithmetic("Fp32s", a, b);
+	// a chain ends in the smallest q, the latency variant mixes q12 with the rest
+	Inputs<Fp32s> am = MakeInputs<Fp32s>(aVals, "q12-20", [](double d, uint32_t i) {
+		return Fp32s(d, MixedQ(i, 12, 16, 20));
+	});
+	Inputs<Fp32s> bm = MakeInputs<Fp32s>(bVals, "q12-20", [](double d, uint32_t i) {
+		return Fp32s(d, MixedQ(i + INPUTS, 12, 16, 20));
+	});
+	AddArithmetic("Fp32s", am, bm);
+	AddUnary("Fp32s", "(int32_t)", a, [](Fp32s x) { return (int32_t)x; });
+	AddUnary("Fp32s", "(int64_t)", a, [](Fp32s x) { return (int64_t)x; });
+	AddUnary("Fp32s", "Fp32s(double)", a, [](Fp32s x) { return Fp32s((double)x.rawVal * 1e-3, 16); });
+	AddUnary("Fp32s", "ToChars", a, [](Fp32s x) { char buf[24]; return x.ToChars(buf, 4); });
+	AddUnary("Fp32s", "FromChars", a, [](Fp32s x) {
+		const char *s = texts[x.rawVal & 7];
+		return Fp32s::FromChars(s, (uint8_t)strlen(s), 16);
+	});
+}
 
-	elapsed_millis = elapsedVal.tv_sec * 1000 + (double) elapsedVal.tv_usec / 1000;
-	user_millis = userVal.tv_sec * 1000 + (double) userVal.tv_usec / 1000;
-	system_millis = systemVal.tv_sec * 1000 + (double) systemVal.tv_usec / 1000;
+static void AddFp32f()
+{
+	Inputs<Fp32f16> a = MakeInputs<Fp32f16>(aVals, "-", [](double d, uint32_t) { return Fp32f16(d); });
+	Inputs<Fp32f16> b = MakeInputs<Fp32f16>(bVals, "-", [](double d, uint32_t) { return Fp32f16(d); });
+	Inputs<int32_t> k;
+	for (uint32_t i = 0; i < INPUTS; i++)
+		k.v[i] = iVals[i % VALS];
+	AddArithmetic("Fp32f<16>", a, b);
+	AddUnary("Fp32f<16>", "-x", a, [](Fp32f16 x) { return -x; });
+	AddBinary("Fp32f<16>", "+ int", a, k, [](Fp32f16 x, int32_t y) { return x + y; });
+	AddBinary("Fp32f<16>", "- int", a, k, [](Fp32f16 x, int32_t y) { return x - y; });
+	AddBinary("Fp32f<16>", "* int", a, k, [](Fp32f16 x, int32_t y) { return x * y; });
+	AddBinary("Fp32f<16>", "/ int", a, k, [](Fp32f16 x, int32_t y) { return x / y; });
+	AddBinary("Fp32f<16>", "*= int", a, k, [](Fp32f16 x, int32_t y) { x *= y; return x; });
+	AddBinary("Fp32f<16>", "/= int", a, k, [](Fp32f16 x, int32_t y) { x /= y; return x; });
+	// y + x would also match the built-in int + (int32_t)x
+	AddBinary("Fp32f<16>", "int +", a, k, [](Fp32f16 x, int32_t y) { return Fp::operator + (y, x); });
+	AddBinary("Fp32f<16>", "int -", a, k, [](Fp32f16 x, int32_t y) { return Fp::operator - (y, x); });
+	AddBinary("Fp32f<16>", "int *", a, k, [](Fp32f16 x, int32_t y) { return Fp::operator * (y, x); });
+	AddBinary("Fp32f<16>", "int /", a, k, [](Fp32f16 x, int32_t y) { return Fp::operator / (y, x); });
+	AddBinary("Fp32f<16>", "== int", a, k, [](const Fp32f16 x, int32_t y) { return x == y; });
+	AddBinary("Fp32f<16>", "!= int", a, k, [](const Fp32f16 x, int32_t y) { return x != y; });
+	AddBinary("Fp32f<16>", "< int", a, k, [](const Fp32f16 x, int32_t y) { return x < y; });
+	AddBinary("Fp32f<16>", "> int", a, k, [](const Fp32f16 x, int32_t y) { return x > y; });
+	AddBinary("Fp32f<16>", "<= int", a, k, [](const Fp32f16 x, int32_t y) { return x <= y; });
+	AddBinary("Fp32f<16>", ">= int", a, k, [](const Fp32f16 x, int32_t y) { return x >= y; });
+	AddUnary("Fp32f<16>", "(int16_t)", a, [](Fp32f16 x) { return (int16_t)x; });
+	AddUnary("Fp32f<16>", "(int32_t)", a, [](Fp32f16 x) { return (int32_t)x; });
+	AddUnary("Fp32f<16>", "(int64_t)", a, [](Fp32f16 x) { return (int64_t)x; });
+	AddUnary("Fp32f<16>", "FromFloat", a, [](Fp32f16 x) { return Fp32f16::FromFloat((float)x.rawVal * 1e-3f); });
+	AddUnary("Fp32f<16>", "ToChars", a, [](Fp32f16 x) { char buf[24]; return x.ToChars(buf, 4); });
+	AddUnary("Fp32f<16>", "FromChars", a, [](Fp32f16 x) {
+		const char *s = texts[x.rawVal & 7];
+		return Fp32f16::FromChars(s, (uint8_t)strlen(s));
+	});
+}
 
-	printf("\n\n---Execution times in milliseconds--- \n");
-	printf("Total:\t\t %f\nUser:\t\t %f\nSystem:\t\t %f\n", elapsed_millis, user_millis, system_millis);
+static void AddFp64f()
+{
+	Inputs<Fp64f32> a = MakeInputs<Fp64f32>(aVals, "-", [](double d, uint32_t) { return Fp64f32(d); });
+	Inputs<Fp64f32> b = MakeInputs<Fp64f32>(bVals, "-", [](double d, uint32_t) { return Fp64f32(d); });
+	AddArithmetic("Fp64f<32>", a, b);
+	AddUnary("Fp64f<32>", "ToChars", a, [](Fp64f32 x) { char buf[40]; return x.ToChars(buf, 9); });
+	AddUnary("Fp64f<32>", "FromChars", a, [](Fp64f32 x) {
+		const char *s = texts[x.rawVal & 7];
+		return Fp64f32::FromChars(s, (uint8_t)strlen(s));
+	});
 }
 
-void PrintMetrics(time_measure * tu, char* testName, uint32_t testCount, double avg)
+// Fp64s(double, q) and Fp64s / go through int32_t, q24 keeps +-100 in range
+static void AddFp64s()
 {
-	struct timeval elapsedVal;
-	struct timeval userVal;
-	struct timeval systemVal;
-
-	double elapsed_millis = 0.0f;
-	double user_millis = 0.0f;
-	double system_millis = 0.0f;
-
-	timersub(&tu->stopTimeVal, &tu->startTimeVal, &elapsedVal);
-	timersub(&tu->stopTimeUsage.ru_utime, &tu->startTimeUsage.ru_utime, &userVal);
-	timersub(&tu->stopTimeUsage.ru_stime, &tu->startTimeUsage.ru_stime, &systemVal);
-
-	elapsed_millis = elapsedVal.tv_sec * 1000 + (double) elapsedVal.tv_usec / 1000;
-	user_millis = userVal.tv_sec * 1000 + (double) userVal.tv_usec / 1000;
-	system_millis = systemVal.tv_sec * 1000 + (double) systemVal.tv_usec / 1000;
-	double timePerSingleTestUs = (elapsed_millis*1000.)/((double)testCount);
-
-	printf("\n\n---%s--- \n", testName);
-	printf(
-		"Total (ms):\t\t\t %f\n"
-		"User (ms):\t\t\t %f\n"
-		"System (ms):\t\t\t %f\n"
-		"Num. Tests:\t\t\t %u\n"
-		"Time Per Single Test (us):\t %f (%.0f%% higher than expected)\n",
-		elapsed_millis,
-		user_millis,
-		system_millis,
-		testCount,
-		timePerSingleTestUs,
-		(timePerSingleTestUs/avg)*100.0);
+	Inputs<Fp64s> a = MakeInputs<Fp64s>(aVals, "q24", [](double d, uint32_t) { return Fp64s(d, 24); });
+	Inputs<Fp64s> b = MakeInputs<Fp64s>(bVals, "q24", [](double d, uint32_t) { return Fp64s(d, 24); });
+	AddArithmetic("Fp64s", a, b);
+	Inputs<Fp64s> am = MakeInputs<Fp64s>(aVals, "q16-24", [](double d, uint32_t i) {
+		return Fp64s(d, MixedQ(i, 16, 20, 24));
+	});
+	Inputs<Fp64s> bm = MakeInputs<Fp64s>(bVals, "q16-24", [](double d, uint32_t i) {
+		return Fp64s(d, MixedQ(i + INPUTS, 16, 20, 24));
+	});
+	AddArithmetic("Fp64s", am, bm);
+	AddUnary("Fp64s", "(int32_t)", a, [](Fp64s x) { return (int32_t)x; });
+	AddUnary("Fp64s", "(int64_t)", a, [](Fp64s x) { return (int64_t)x; });
 }
 
-int main()
+int main(int argc, char *argv[])
 {
-	Fp32f<8> fp1 = Fp32f<8>(5.6);
-	Fp32f<8> fp2 = Fp32f<8>(8.9);
-	Fp32f<8> fp3;
-	
-	Fp64f<8> fp64f1 = Fp64f<8>(5.6);
-	Fp64f<8> fp64f2 = Fp64f<8>(8.9);
-	Fp64f<8> fp64f3;
-	
-	Fp64s fp64s1 = Fp64s(5.6, 12);
-	Fp64s fp64s2 = Fp64s(8.9, 12);
-	Fp64s fp64s3;
-
-	time_measure * tu = StartTimeMeasuring();
-	
-	{	
-		int x = 0;
-		for(x = 0; x < NUM_TESTS; x++)
-		{
-			fp3 = fp1 + fp2;
+	Options opt;
+	const char *filter = 0;
+	bool json = false;
+	bool count = true;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0)
+			json = true;
+		else if (strcmp(argv[i], "--no-counters") == 0)
+			count = false;
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			filter = argv[++i];
+		else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+			opt.samples = (uint32_t)strtoul(argv[++i], 0, 10);
+		else if (strcmp(argv[i], "--min-sample-us") == 0 && i + 1 < argc)
+			opt.min_sample_ns = strtoull(argv[++i], 0, 10) * 1000;
+		else if (strcmp(argv[i], "--warmup-ms") == 0 && i + 1 < argc)
+			opt.warmup_ns = strtoull(argv[++i], 0, 10) * 1000000;
+		else {
+			fprintf(stderr, "usage: %s [--json] [--filter TEXT] [--samples N] "
+				"[--min-sample-us N] [--warmup-ms N] [--no-counters]\n", argv[0]);
+			return 2;
 		}
-	
 	}
-	
-	StopTimeMeasuring(tu);
-	PrintMetrics(tu, (char*)"Fp32f Addition", NUM_TESTS, ADDITION_AVG);
-	//PrintMeasuredTime(tu);
-	free(tu);
-	
-	tu = StartTimeMeasuring();
-	
-	{	
-		int x = 0;
-		for(x = 0; x < NUM_TESTS; x++)
-		{
-			fp3 = fp1 - fp2;
-		}
-	
-	}
-	
-	StopTimeMeasuring(tu);
-	PrintMetrics(tu, (char*)"Fp32f Subtraction", NUM_TESTS, SUBTRACTION_AVG);
-	//PrintMeasuredTime(tu);
-	free(tu);
-	
-	tu = StartTimeMeasuring();
-	
-	{	
-		int x = 0;
-		for(x = 0; x < NUM_TESTS; x++)
-		{
-			fp64f3 = fp64f1 - fp64f2;
-		}
-	
-	}
-	
-	StopTimeMeasuring(tu);
-	PrintMetrics(tu, (char*)"Fp64f Subtraction", NUM_TESTS, SUBTRACTION_AVG);
-	//PrintMeasuredTime(tu);
-	free(tu);
-	
-	tu = StartTimeMeasuring();
-	
-	{	
-		int x = 0;
-		for(x = 0; x < NUM_TESTS; x++)
-		{
-			fp64s3 = fp64s1 + fp64s2;
-		}
-	
-	}
-	
-	StopTimeMeasuring(tu);
-	PrintMetrics(tu, (char*)"Fp64s Addition", NUM_TESTS, SUBTRACTION_AVG);
-	free(tu);
-	
-	tu = StartTimeMeasuring();
-	
-	{	
-		int x = 0;
-		for(x = 0; x < NUM_TESTS; x++)
-		{
-			fp64s3 = fp64s1 - fp64s2;
-		}
-	
-	}
-	
-	StopTimeMeasuring(tu);
-	PrintMetrics(tu, (char*)"Fp64s Subtraction", NUM_TESTS, SUBTRACTION_AVG);
-	free(tu);
+	if (opt.samples == 0)
+		opt.samples = 1;
+
+	AddLoop();
+	AddFp32s();
+	AddFp32f();
+	AddFp64f();
+	AddFp64s();
+	RunAll(opt, filter, json, count);
+	return 0;
 }
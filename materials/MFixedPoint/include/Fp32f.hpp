@@ -60,6 +60,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Port-specific code
 #include "Port.hpp"
 
+// The kernels below are the ones of the sketch library (lib/MFixedPoint)
+
+// Compile-time literal parser
+#include "../../../lib/MFixedPoint/FpLiteral.hpp"
+
+// Widening multiply kernel
+#include "../../../lib/MFixedPoint/FpMul.hpp"
+
+// Reciprocal division
+#include "../../../lib/MFixedPoint/FpDiv.hpp"
+
+// Fixed-point to float
+#include "../../../lib/MFixedPoint/FpFloat.hpp"
+
+// Fixed-point to decimal text
+#include "../../../lib/MFixedPoint/FpChars.hpp"
+
 namespace Fp
 {
 
@@ -69,18 +86,19 @@ namespace Fp
 	//! @brief		Perform a fixed point multiplication without a 64-bit intermediate result.
 	//!	@note 		This is fast but beware of intermediary overflow!
 	template <uint8_t q> 
-	inline int32_t FixMulF(int32_t a, int32_t b)
+	constexpr int32_t FixMulF(int32_t a, int32_t b)
 	{
 		return (a * b) >> q;
 	}
 
 	//! @brief		Perform a fixed point multiplication using a 64-bit intermediate result to
 	//! 			prevent intermediary overflow problems.
-	//! @note 		Slower than Fp32f::FixMulF()
+	//! @note 		Slower than Fp32f::FixMulF(). On AVR the widening multiply is done
+	//!				by the mul kernel in FpMul.hpp.
 	template <uint8_t q>
-	inline int32_t FixMul(int32_t a, int32_t b)
+	constexpr int32_t FixMul(int32_t a, int32_t b)
 	{
-		return (int32_t)(((int64_t)a * b) >> q);
+		return detail::mul32_shr(a, b, q);
 	}
 
 	// Fixed point division
@@ -106,6 +124,14 @@ namespace Fp
 		#endif
 	}
 
+	//! @brief		Fixed point division by a Newton-Raphson reciprocal, no 64-bit divide.
+	//! @details	Same result as fixdiv() with DIV_EXACT, see FpDiv.hpp for the other levels.
+	template <uint8_t q, DivMode mode = FP_DIV_MODE>
+	inline int32_t FixDivRcp(int32_t a, int32_t b)
+	{
+		return detail::div32_shl(a, b, q, mode);
+	}
+
 	namespace detail {
 		inline uint32_t CountLeadingZeros(uint32_t x)
 		{
@@ -179,21 +205,22 @@ namespace Fp
 	//! @brief		Converts from float to a raw fixed-point number.
 	//! @details	Do not write "myFpNum = FloatToRawFix32()"! This function outputs a raw
 	//!				number, so you would have to use the syntax "myFpNum.rawVal = FloatToRawFix32()".
-	//! @warning	Slow!
+	//! @note		Rounded toward zero. Free when used in a constant expression, on AVR
+	//!				built from the float bits at runtime and saturated (FpFloat.hpp).
 	template <uint8_t q>
-	int32_t FloatToRawFix32(float f)
+	constexpr int32_t FloatToRawFix32(float f)
 	{
-		return (int32_t)(f * (1 << q));
+		return detail::float_to_fix32(f, q);
 	}
 	
 	//! @brief		Converts from double to a raw fixed-point number.
 	//! @details	Do not write "myFpNum = FloatToRawFix32()"! This function outputs a raw
 	//!				number, so you would have to use the syntax "myFpNum.rawVal = FloatToRawFix32()".
-	//! @warning	Slow!
+	//! @note		Same as FloatToRawFix32() where double is float (AVR).
 	template <uint8_t q>
-	int32_t DoubleToRawFix32(double f)
+	constexpr int32_t DoubleToRawFix32(double f)
 	{
-		return (int32_t)(f * (double)(1 << q));
+		return detail::double_to_fix32(f, q);
 	}
 	
 	
@@ -209,6 +236,16 @@ namespace Fp
 	template <uint8_t q>
 	class Fp32f {
 		
+		private:
+		
+		struct RawTag {};
+		
+		constexpr Fp32f(RawTag, int32_t raw) :
+			rawVal(raw)
+		{
+		
+		}
+		
 		public:
 		
 		//! @brief		The fixed-point number is stored in this basic data type.
@@ -221,36 +258,51 @@ namespace Fp
 			#endif
 		}
 		
-		Fp32f(int8_t i) :
-			rawVal((int32_t)i << q)
+		//! @note		All constructors are constexpr. Integers are shifted as unsigned, as
+		//!				left shift of a negative number is not a constant expression.
+		constexpr Fp32f(int8_t i) :
+			rawVal((int32_t)((uint32_t)(int32_t)i << q))
 		{
 			
 		}
 		
-		Fp32f(int16_t i) :
-			rawVal((int32_t)i << q)
+		constexpr Fp32f(int16_t i) :
+			rawVal((int32_t)((uint32_t)(int32_t)i << q))
 		{
 			
 		}
 		
-		Fp32f(int32_t i) :
-			rawVal(i << q)
+		constexpr Fp32f(int32_t i) :
+			rawVal((int32_t)((uint32_t)i << q))
 		{
 		
 		}
 		
-		Fp32f(float f) :
+		constexpr Fp32f(float f) :
 			rawVal(FloatToRawFix32<q>(f))
 		{
 		
 		}
 		
-		Fp32f(double f) :
+		constexpr Fp32f(double f) :
 			rawVal(FloatToRawFix32<q>((float)f))
 		{
 		
 		}
 		
+		//! @brief		Builds the number from the raw value (no shift).
+		static constexpr Fp32f FromRaw(int32_t raw)
+		{
+			return Fp32f(RawTag(), raw);
+		}
+		
+		//! @brief		Builds the number from a float without soft-float code,
+		//!				rounded as asked and saturated (see FpFloat.hpp).
+		static Fp32f FromFloat(float f, FloatRound round = ROUND_NEAREST)
+		{
+			return Fp32f(RawTag(), detail::float_to_fix32_bits(f, q, round));
+		}
+		
 		// Compound Arithmetic Overloads
 		
 		Fp32f& operator += (Fp32f r)
@@ -274,10 +326,10 @@ namespace Fp
 		}
 		
 		//! @brief		Overlaod for '/=' operator.
-		//! @details	Uses intermediatary casting to int64_t to prevent overflows.
+		//! @details	Used the FixDivRcp() method (FP_DIV_MODE accuracy).
 		Fp32f& operator /= (Fp32f r)
 		{
-			rawVal = fixdiv<q>(rawVal, r.rawVal);
+			rawVal = FixDivRcp<q>(rawVal, r.rawVal);
 			return *this;
 		}
 		
@@ -394,41 +446,61 @@ namespace Fp
 		//! @brief		Conversion operator from fixed-point to int16_t.
 		//! @warning	Possible loss of accuracy from conversion from
 		//!				int32_t to int16_t.
-		operator int16_t()
+		constexpr operator int16_t() const
 		{
 			// Right-shift to get rid of all the decimal bits (truncate)
 			return (int16_t)(rawVal >> q);
 		}
 		
 		//! @brief		Conversion operator from fixed-point to int32_t.
-		operator int32_t()
+		constexpr operator int32_t() const
 		{
 			// Right-shift to get rid of all the decimal bits (truncate)
 			return (rawVal >> q);
 		}
 		
 		//! @brief		Conversion operator from fixed-point to int64_t.
-		operator int64_t()
+		constexpr operator int64_t() const
 		{
 			// Right-shift to get rid of all the decimal bits (truncate)
 			return (int64_t)(rawVal >> q);
 		}
 		
 		//! @brief		Conversion operator from fixed-point to float.
-		operator float()
+		constexpr operator float() const
 		{ 
-			return (float)rawVal / (float)(1 << q);
+			return detail::fix32_to_float(rawVal, q);
 		}
 		
 		//! @brief		Conversion operator from fixed-point to double.
 		//! @note		Similar to float conversion.
-		operator double()
+		constexpr operator double() const
 		{ 
-			return (double)rawVal / (double)(1 << q);
+			return detail::fix32_to_double(rawVal, q);
 		}
 		
 		//! @}
 		
+		//! @brief		Writes the number as decimal text with the given number of
+		//!				fractional digits (rounded) and '\0', returns the text length.
+		//! @details	No float, printf or division (FpChars.hpp). buf must hold
+		//!				13 + digits chars.
+		uint8_t ToChars(char *buf, uint8_t digits) const
+		{
+			return detail::fix32_to_chars(buf, rawVal, q, digits);
+		}
+		
+		//! @brief		Parses decimal text "[+|-]digits[.digits]" (len chars at most),
+		//!				rounded to nearest and saturated, 0 if s does not start with a number.
+		//! @details	No float or division (FpChars.hpp), parsing stops at the first
+		//!				character that does not fit.
+		static Fp32f FromChars(const char *s, uint8_t len)
+		{
+			int32_t raw;
+			detail::chars_to_fix32(s, len, q, raw);
+			return Fp32f(RawTag(), raw);
+		}
+		
 		// Overloads Between Fp32f And int32_t
 
 		
@@ -492,6 +564,54 @@ namespace Fp
 		
 	};
 
+	//! @brief		Fixed-point literals: 0.01_q7 is Fp32f<7>(0.01) built by the compiler.
+	//! @details	_q0 .. _q31 give the number of fractional bits. The value is rounded to
+	//!				nearest, the build fails if it does not fit or rounds to zero.
+	//!				Use with: using namespace Fp::fast_literals;
+	namespace fast_literals
+	{
+		#define FP32F_LITERAL(Q) \
+			template <char... c> \
+			constexpr Fp32f<Q> operator"" _q##Q() \
+			{ \
+				return Fp32f<Q>::FromRaw((int32_t)detail::FixedLiteral<Q, 0x7fffffffUL, c...>::raw); \
+			}
+		
+	FP32F_LITERAL(0)
+	FP32F_LITERAL(1)
+	FP32F_LITERAL(2)
+	FP32F_LITERAL(3)
+	FP32F_LITERAL(4)
+	FP32F_LITERAL(5)
+	FP32F_LITERAL(6)
+	FP32F_LITERAL(7)
+	FP32F_LITERAL(8)
+	FP32F_LITERAL(9)
+	FP32F_LITERAL(10)
+	FP32F_LITERAL(11)
+	FP32F_LITERAL(12)
+	FP32F_LITERAL(13)
+	FP32F_LITERAL(14)
+	FP32F_LITERAL(15)
+	FP32F_LITERAL(16)
+	FP32F_LITERAL(17)
+	FP32F_LITERAL(18)
+	FP32F_LITERAL(19)
+	FP32F_LITERAL(20)
+	FP32F_LITERAL(21)
+	FP32F_LITERAL(22)
+	FP32F_LITERAL(23)
+	FP32F_LITERAL(24)
+	FP32F_LITERAL(25)
+	FP32F_LITERAL(26)
+	FP32F_LITERAL(27)
+	FP32F_LITERAL(28)
+	FP32F_LITERAL(29)
+	FP32F_LITERAL(30)
+	FP32F_LITERAL(31)
+		#undef FP32F_LITERAL
+	} // namespace fast_literals
+
 	// Specializations for use with plain integers
 
 	//! @note 		Assumes integer has the same precision as Fp32f
@@ -27,6 +27,20 @@
 // Port-specific code
 #include "Port.hpp"
 
+// The kernels below are the ones of the sketch library (lib/MFixedPoint)
+
+// Widening multiply kernel
+#include "../../../lib/MFixedPoint/FpMul.hpp"
+
+// Reciprocal division
+#include "../../../lib/MFixedPoint/FpDiv.hpp"
+
+// Fixed-point to float
+#include "../../../lib/MFixedPoint/FpFloat.hpp"
+
+// Fixed-point to decimal text
+#include "../../../lib/MFixedPoint/FpChars.hpp"
+
 namespace Fp
 {
 
@@ -58,7 +72,7 @@ namespace Fp
 		
 		Fp32s(double dbl, uint8_t qin)
 		{
-			rawVal = (int32_t)(dbl * (1 << qin));
+			rawVal = detail::double_to_fix32(dbl, qin);
 			q = qin;
 		}
 		
@@ -119,7 +133,8 @@ namespace Fp
 		}
 		
 		//! @brief		Overlaod for '*=' operator.
-		//! @details	Uses intermediatary casting to int64_t to prevent overflows.
+		//! @details	Same result as casting to int64_t to prevent overflows, the 32x32->64
+		//!				multiplication and the shift are done by detail::mul32_shr (FpMul.hpp).
 		Fp32s& operator *= (Fp32s r)
 		{
 			// Optimised for when q is the same for both
@@ -127,48 +142,56 @@ namespace Fp
 			if(q == r.q)
 			{
 				// Q the same for both numbers, shift right by Q
-				rawVal = (int32_t)(((int64_t)rawVal * (int64_t)r.rawVal) >> q);
+				rawVal = detail::mul32_shr(rawVal, r.rawVal, q);
 				// No need to change Q, both are the same
 			}
 			else if(q > r.q)
 			{
 				// Second number has smaller Q, so result is in that precision
-				rawVal = (int32_t)((((int64_t)rawVal >> (q - r.q)) * (int64_t)r.rawVal) >> r.q); 
+				rawVal = detail::mul32_shr(rawVal >> (q - r.q), r.rawVal, r.q);
 				// Change Q
 				q = r.q;
 			}
 			else // q < r.q
 			{
 				// First number has smaller Q, so result is in that precision
-				rawVal = (int32_t)(((int64_t)rawVal * ((int64_t)r.rawVal >> (r.q - q))) >> q); 
+				rawVal = detail::mul32_shr(rawVal, r.rawVal >> (r.q - q), q);
 				// No need to change Q
 			}
 			return *this;
 		}
 		
 		//! @brief		Overlaod for '/=' operator.
-		//! @details	Uses intermediatary casting to int64_t to prevent overflows.
+		//! @details	Reciprocal division of FpDiv.hpp with the FP_DIV_MODE accuracy,
+		//!				by default the same result as the int64_t division.
 		Fp32s& operator /= (Fp32s r)
+		{
+			return div<FP_DIV_MODE>(r);
+		}
+		
+		//! @brief		Division with the given accuracy (see DivMode in FpDiv.hpp).
+		template <DivMode mode>
+		Fp32s& div(Fp32s r)
 		{
 			// Optimised for when q is the same for both
 			// operators (first if statement).
 			if(q == r.q)
 			{
-				// Q the same for both numbers, shift right by Q
-				rawVal = (int32_t)((((int64_t)rawVal << q) / (int64_t)r.rawVal));
+				// Q the same for both numbers, shift left by Q
+				rawVal = detail::div32_shl(rawVal, r.rawVal, q, mode);
 				// No need to change Q, both are the same
 			}
 			else if(q > r.q)
 			{
 				// Second number has smaller Q, so result is in that precision
-				rawVal = (int32_t)(((((int64_t)rawVal >> (q - r.q)) << r.q) / (int64_t)r.rawVal)); 
+				rawVal = detail::div32_shl(rawVal >> (q - r.q), r.rawVal, r.q, mode);
 				// Change Q
 				q = r.q;
 			}
 			else // q < r.q
 			{
 				// First number has smaller Q, so result is in that precision
-				rawVal = (int32_t)(((int64_t)rawVal << q) / ((int64_t)r.rawVal >> (r.q - q))); 
+				rawVal = detail::div32_shl(rawVal, r.rawVal >> (r.q - q), q, mode);
 				// No need to change Q
 			}
 			return *this;
@@ -402,14 +425,35 @@ namespace Fp
 		//! @note		Similar to double conversion.
 		operator float()
 		{ 
-			return (float)rawVal / (float)(1 << q);
+			return detail::fix32_to_float(rawVal, q);
 		}
 		
 		//! @brief		Conversion operator from fixed-point to double.
 		//! @note		Similar to float conversion.
 		operator double()
 		{ 
-			return (double)rawVal / (double)(1 << q);
+			return detail::fix32_to_double(rawVal, q);
+		}
+		
+		//! @brief		Writes the number as decimal text with the given number of
+		//!				fractional digits (rounded) and '\0', returns the text length.
+		//! @details	No float, printf or division (FpChars.hpp). buf must hold
+		//!				13 + digits chars.
+		uint8_t ToChars(char *buf, uint8_t digits) const
+		{
+			return detail::fix32_to_chars(buf, rawVal, q, digits);
+		}
+		
+		//! @brief		Parses decimal text "[+|-]digits[.digits]" (len chars at most),
+		//!				rounded to nearest and saturated, 0 if s does not start with a number.
+		//! @details	No float or division (FpChars.hpp), parsing stops at the first
+		//!				character that does not fit.
+		static Fp32s FromChars(const char *s, uint8_t len, uint8_t qin)
+		{
+			Fp32s x;
+			detail::chars_to_fix32(s, len, qin, x.rawVal);
+			x.q = qin;
+			return x;
 		}
 		
 	};
@@ -21,13 +21,21 @@
 
 #include <stdint.h>
 
+// The kernels below are the ones of the sketch library (lib/MFixedPoint)
+
+// Reciprocal division
+#include "../../../lib/MFixedPoint/FpDiv.hpp"
+
+// Fixed-point to decimal text
+#include "../../../lib/MFixedPoint/FpChars.hpp"
+
 namespace Fp
 {
 
 	//! @brief		Perform a fixed point multiplication without a 128-bit intermediate result.
 	//!	@warning	This is fast but beware of intermediary overflow!
 	template <uint8_t p> 
-	inline int64_t FixMulF(int64_t a, int64_t b)
+	constexpr int64_t FixMulF(int64_t a, int64_t b)
 	{
 		// Rule with fixed-point multiplication, you have
 		// to right-shift result by the precision.
@@ -45,24 +53,33 @@ namespace Fp
 		return (int64_t)(((a) << p) / b);
 	}
 
+	//! @brief		Fixed point division by a Newton-Raphson reciprocal, no 64-bit divide.
+	//! @details	Same result as FixDiv() with DIV_EXACT, see FpDiv.hpp for the other levels.
+	//!	@warning	a << p must fit int64_t, as for FixDiv().
+	template <uint8_t p, DivMode mode = FP_DIV_MODE>
+	inline int64_t FixDivRcp(int64_t a, int64_t b)
+	{
+		return detail::div64_shl(a, b, p, mode);
+	}
+
 	//! @brief		Converts from float to a raw fixed-point number.
 	//! @details	Do not write "myFpNum = FloatToRawFix64()"! This function outputs a raw
 	//!				number, so you would have to use the syntax "myFpNum.rawVal = FloatToRawFix64()".
-	//! @warning	Slow!
+	//! @warning	Slow at runtime, free when used in a constant expression.
 	template <uint8_t p>
-	int64_t FloatToRawFix64(float f)
+	constexpr int64_t FloatToRawFix64(float f)
 	{
-		return (int64_t)(f * (1 << p));
+		return (int64_t)(f * (float)((uint64_t)1 << p));
 	}
 	
 	//! @brief		Converts from float to a raw fixed-point number.
 	//! @details	Do not write "myFpNum = DoubleToRawFix64()"! This function outputs a raw
 	//!				number, so you would have to use the syntax "myFpNum.rawVal = DoubleToRawFix64()".
-	//! @warning	Slow!
+	//! @warning	Slow at runtime, free when used in a constant expression.
 	template <uint8_t p>
-	int64_t DoubleToRawFix64(double f)
+	constexpr int64_t DoubleToRawFix64(double f)
 	{
-		return (int64_t)(f * (double)(1 << p));
+		return (int64_t)(f * (double)((uint64_t)1 << p));
 	}
 
 	//! @brief		64-bit fixed-point library.
@@ -85,25 +102,26 @@ namespace Fp
 			//! @brief			Constructor taking a int32_t.
 			//! @details		Uses initialiser lists. Make sure i is cast
 			//!					to 64-bit before shifting, otherwise truncation
-			//!					will occur.
-			Fp64f(int32_t i) :
-				rawVal((int64_t)i << p)
+			//!					will occur. Shifted as unsigned, as left shift of a
+			//!					negative number is not a constant expression.
+			constexpr Fp64f(int32_t i) :
+				rawVal((int64_t)((uint64_t)(int64_t)i << p))
 			{
 				// nothing
 			}
 			
-			Fp64f(int64_t i) :
-				rawVal(i << p)
+			constexpr Fp64f(int64_t i) :
+				rawVal((int64_t)((uint64_t)i << p))
 			{
 				// nothing
 			}
 			
-			Fp64f(float f) :
+			constexpr Fp64f(float f) :
 				rawVal(FloatToRawFix64<p>(f))
 			{
 				// nothing
 			}
-			Fp64f(double f) :
+			constexpr Fp64f(double f) :
 				rawVal(FloatToRawFix64<p>((double)f))
 			{
 				// nothing
@@ -140,10 +158,10 @@ namespace Fp
 			}
 			
 			//! @brief		Override for "/=".
-			//! @details	Used the FixDiv() method.
+			//! @details	Used the FixDivRcp() method.
 			Fp64f& operator /= (Fp64f r)
 			{ 
-				rawVal = FixDiv<p>(rawVal, r.rawVal);
+				rawVal = FixDivRcp<p>(rawVal, r.rawVal);
 				return *this;
 			}
 			
@@ -240,20 +258,40 @@ namespace Fp
 			//! @{
 			
 			//! @brief		Conversion operator from fixed-point to float.
-			operator float()
+			constexpr operator float() const
 			{ 
-				return (float)rawVal / (float)(1 << p);
+				return (float)rawVal / (float)((uint64_t)1 << p);
 			}
 			
 			//! @brief		Conversion operator from fixed-point to double.
 			//! @note		Similar to float conversion.
-			operator double()
+			constexpr operator double() const
 			{ 
-				return (double)rawVal / (double)(1 << p);
+				return (double)rawVal / (double)((uint64_t)1 << p);
 			}
 			
 			//! @}
 			
+			//! @brief		Writes the number as decimal text with the given number of
+			//!				fractional digits (rounded) and '\0', returns the text length.
+			//! @details	No float, printf or division (FpChars.hpp). buf must hold
+			//!				23 + digits chars.
+			uint8_t ToChars(char *buf, uint8_t digits) const
+			{
+				return detail::fix64_to_chars(buf, rawVal, p, digits);
+			}
+			
+			//! @brief		Parses decimal text "[+|-]digits[.digits]" (len chars at most),
+			//!				rounded to nearest and saturated, 0 if s does not start with a number.
+			//! @details	No float or division (FpChars.hpp), parsing stops at the first
+			//!				character that does not fit.
+			static Fp64f FromChars(const char *s, uint8_t len)
+			{
+				Fp64f x;
+				detail::chars_to_fix64(s, len, p, x.rawVal);
+				return x;
+			}
+			
 		private:
 			
 			// none
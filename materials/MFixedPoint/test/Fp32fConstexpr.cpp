@@ -0,0 +1,58 @@
+//!
+//! @file 				Fp32fConstexpr.cpp
+//! @author 			AndrewBiz
+//! @edited 			n/a
+//! @created			2026-10-16
+//! @last-modified		2026-10-16
+//! @brief 				Checks that Fp32f numbers can be built in constant expressions.
+//! @details
+//!		See README.rst in root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+// none
+
+//===== USER LIBRARIES =====//
+#include "MUnitTest/api/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MFixedPointApi.hpp"
+
+using namespace Fp;
+
+// Compile-time checks, the build fails if any of these is not a constant expression
+static constexpr Fp32f<8> constFp1 = Fp32f<8>(5.6);
+static constexpr Fp32f<8> constFp2 = Fp32f<8>((int32_t)-3);
+static constexpr Fp32f<12> constFp3 = Fp32f<12>((int16_t)-7);
+static_assert(constFp1.rawVal == 1433, "Fp32f<8>(5.6) is not 1433");
+static_assert(constFp2.rawVal == -768, "Fp32f<8>(-3) is not -768");
+static_assert(constFp3.rawVal == -7*4096, "Fp32f<12>(-7) is not -7*4096");
+static_assert((int32_t)constFp2 == -3, "Fp32f<8>(-3) to int32_t is not -3");
+static_assert(FloatToRawFix32<16>(0.5f) == 32768, "FloatToRawFix32<16>(0.5) is not 32768");
+static_assert(FixMul<8>(512, 768) == 1536, "FixMul<8>(2, 3) is not 6");
+
+MTEST_GROUP(Fp32fConstexprTests)
+{
+	MTEST(ConstexprSameAsRuntimeTest)
+	{
+		volatile double dbl = 5.6;
+		Fp32f<8> fp1 = Fp32f<8>((double)dbl);
+
+		CHECK_EQUAL(constFp1.rawVal, fp1.rawVal);
+	}
+
+	MTEST(ConstexprNegativeIntTest)
+	{
+		volatile int32_t i = -3;
+		Fp32f<8> fp1 = Fp32f<8>((int32_t)i);
+
+		CHECK_EQUAL(constFp2.rawVal, fp1.rawVal);
+	}
+
+	MTEST(ConstexprTableTest)
+	{
+		static constexpr Fp32f<16> table[] = { Fp32f<16>(0.25), Fp32f<16>(0.5), Fp32f<16>(0.75) };
+
+		CHECK_EQUAL(table[0].rawVal, (int32_t)16384);
+		CHECK_EQUAL(table[2].rawVal, (int32_t)49152);
+	}
+}
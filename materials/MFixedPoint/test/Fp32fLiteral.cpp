@@ -0,0 +1,54 @@
+//!
+//! @file 				Fp32fLiteral.cpp
+//! @author 			AndrewBiz
+//! @edited 			n/a
+//! @created			2026-10-16
+//! @last-modified		2026-10-16
+//! @brief 				Performs unit tests on the compile-time Fp32f literals.
+//! @details
+//!		See README.rst in root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+// none
+
+//===== USER LIBRARIES =====//
+#include "MUnitTest/api/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MFixedPointApi.hpp"
+
+using namespace Fp;
+using namespace Fp::fast_literals;
+
+// Compile-time checks, literals are rounded to nearest
+static_assert((0.01_q7).rawVal == 1, "0.01_q7 is not 1");
+static_assert((125e6_q0).rawVal == 125000000, "125e6_q0 is not 125000000");
+static_assert((5.6_q8).rawVal == 1434, "5.6_q8 is not round(5.6 * 256)");
+static_assert((1.5e-3_q16).rawVal == 98, "1.5e-3_q16 is not round(0.0015 * 65536)");
+static_assert((16777215.99_q7).rawVal == 2147483647, "16777215.99_q7 is not INT32_MAX");
+static_assert((0.0_q31).rawVal == 0, "0.0_q31 is not 0");
+
+MTEST_GROUP(Fp32fLiteralTests)
+{
+	MTEST(PositiveLiteralTest)
+	{
+		Fp32f<12> fp1 = 3.25_q12;
+
+		CHECK_EQUAL(fp1.rawVal, (int32_t)(13 << 10));
+	}
+
+	MTEST(NegativeLiteralTest)
+	{
+		Fp32f<8> fp1 = -3.2_q8;
+
+		// Math.Round(3.2*2^8) = 819
+		CHECK_EQUAL(fp1.rawVal, (int32_t)-819);
+	}
+
+	MTEST(LiteralArithmeticTest)
+	{
+		Fp32f<8> fp1 = 3.2_q8 + 0.6_q8;
+
+		CHECK_CLOSE(3.8, (float)fp1, 0.01);
+	}
+}
@@ -10,6 +10,7 @@
 
 //===== SYSTEM LIBRARIES =====//
 #include <stdio.h>
+#include <string.h>
 
 //===== USER LIBRARIES =====//
 #include "MUnitTest/api/MUnitTestApi.hpp"
@@ -108,4 +109,45 @@ MTEST_GROUP(Fp32fTypeConversionTests)
 
 	}
 
+	MTEST(FromFloatTest)
+	{
+		// 4.6 * 256 = 1177.6
+		CHECK_EQUAL(Fp32f<8>::FromFloat(4.6f).rawVal, 1178);
+		CHECK_EQUAL(Fp32f<8>::FromFloat(4.6f, ROUND_TRUNC).rawVal, 1177);
+		CHECK_EQUAL(Fp32f<8>::FromFloat(-4.6f).rawVal, -1178);
+		CHECK_EQUAL(Fp32f<8>::FromFloat(-4.6f, ROUND_TRUNC).rawVal, -1177);
+	}
+
+	MTEST(FromFloatSaturateTest)
+	{
+		CHECK_EQUAL(Fp32f<8>::FromFloat(1e10f).rawVal, INT32_MAX);
+		CHECK_EQUAL(Fp32f<8>::FromFloat(-1e10f).rawVal, INT32_MIN);
+		CHECK_EQUAL(Fp32f<8>::FromFloat(-8388608.0f).rawVal, INT32_MIN);
+	}
+
+	MTEST(ToCharsTest)
+	{
+		char buf[16];
+		Fp32f<8> fp1 = Fp32f<8>(4.6);
+
+		// 1177 / 256 = 4.59765625
+		CHECK_EQUAL(fp1.ToChars(buf, 2), 4);
+		CHECK_EQUAL(strcmp(buf, "4.60"), 0);
+		CHECK_EQUAL(fp1.ToChars(buf, 0), 1);
+		CHECK_EQUAL(strcmp(buf, "5"), 0);
+	}
+
+	MTEST(FromCharsTest)
+	{
+		// 4.6 * 256 = 1177.6
+		Fp32f<8> fp1 = Fp32f<8>::FromChars("4.6", 3);
+		CHECK_EQUAL(fp1.rawVal, 1178);
+		Fp32f<8> fp2 = Fp32f<8>::FromChars("-4.6", 4);
+		CHECK_EQUAL(fp2.rawVal, -1178);
+		Fp32f<8> fp3 = Fp32f<8>::FromChars("1000000000", 10);
+		CHECK_EQUAL(fp3.rawVal, 2147483647);
+		Fp32f<8> fp4 = Fp32f<8>::FromChars("Hz", 2);
+		CHECK_EQUAL(fp4.rawVal, 0);
+	}
+
 }
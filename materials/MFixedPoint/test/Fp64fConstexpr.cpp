@@ -0,0 +1,45 @@
+//!
+//! @file 				Fp64fConstexpr.cpp
+//! @author 			AndrewBiz
+//! @edited 			n/a
+//! @created			2026-10-16
+//! @last-modified		2026-10-16
+//! @brief 				Checks that Fp64f numbers can be built in constant expressions.
+//! @details
+//!		See README.rst in root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+// none
+
+//===== USER LIBRARIES =====//
+#include "MUnitTest/api/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MFixedPointApi.hpp"
+
+using namespace Fp;
+
+// Compile-time checks, the build fails if any of these is not a constant expression
+static constexpr Fp64f<8> constFp1 = Fp64f<8>(5.5);
+static constexpr Fp64f<40> constFp2 = Fp64f<40>((int32_t)-3);
+static constexpr Fp64f<32> constFp3 = Fp64f<32>((int64_t)125000000);
+static_assert(constFp1.rawVal == 1408, "Fp64f<8>(5.5) is not 1408");
+static_assert(constFp2.rawVal == -3*((int64_t)1 << 40), "Fp64f<40>(-3) is not -3*2^40");
+static_assert(constFp3.rawVal == (int64_t)125000000 << 32, "Fp64f<32>(125000000) is not 125000000*2^32");
+static_assert(FloatToRawFix64<40>(0.5f) == ((int64_t)1 << 39), "FloatToRawFix64<40>(0.5) is not 2^39");
+
+MTEST_GROUP(Fp64fConstexprTests)
+{
+	MTEST(ConstexprSameAsRuntimeTest)
+	{
+		volatile int32_t i = -3;
+		Fp64f<40> fp1 = Fp64f<40>((int32_t)i);
+
+		CHECK_EQUAL(constFp2.rawVal, fp1.rawVal);
+	}
+
+	MTEST(ConstexprToDoubleTest)
+	{
+		CHECK_CLOSE(5.5, (double)constFp1, 0.001);
+	}
+}
@@ -9,7 +9,7 @@
 //!		See README.rst in root dir for more info.
 
 //===== SYSTEM LIBRARIES =====//
-// none
+#include <string.h>
 
 //===== USER LIBRARIES =====//
 #include "MUnitTest/api/MUnitTestApi.hpp"
@@ -82,4 +82,24 @@ MTEST_GROUP(Fp64fTypeConversionTests)
 		CHECK_CLOSE(-(double)(((int64_t)1 << 54)), (double)fp1, 1e2);
 	}
 
+	MTEST(ToCharsTest)
+	{
+		char buf[32];
+		Fp64f<40> fp1 = Fp64f<40>(-3.25);
+
+		CHECK_EQUAL(fp1.ToChars(buf, 3), 6);
+		CHECK_EQUAL(strcmp(buf, "-3.250"), 0);
+		CHECK_EQUAL(fp1.ToChars(buf, 1), 4);
+		CHECK_EQUAL(strcmp(buf, "-3.3"), 0);
+	}
+
+	MTEST(FromCharsTest)
+	{
+		Fp64f<40> fp1 = Fp64f<40>::FromChars("-3.25", 5);
+		CHECK((fp1.rawVal == -((int64_t)13 << 38)));
+		// 0.1 * 2^40 = 109951162777.6
+		Fp64f<40> fp2 = Fp64f<40>::FromChars("0.1", 3);
+		CHECK((fp2.rawVal == 109951162778LL));
+	}
+
 }
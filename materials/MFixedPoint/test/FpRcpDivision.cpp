@@ -0,0 +1,134 @@
+//!
+//! @file 				FpRcpDivision.cpp
+//! @author 			AndrewBiz
+//! @edited 			n/a
+//! @created			2026-10-16
+//! @last-modified		2026-10-16
+//! @brief 				Unit tests for the reciprocal division of Fp32f and Fp64f (FpDiv.hpp).
+//! @details
+//!		See README.rst in root dir for more info.
+
+//===== SYSTEM LIBRARIES =====//
+#include <stdint.h>
+
+//===== USER LIBRARIES =====//
+#include "MUnitTest/api/MUnitTestApi.hpp"
+
+//===== USER SOURCE =====//
+#include "../api/MFixedPointApi.hpp"
+
+using namespace Fp;
+
+namespace
+{
+	// xorshift64, fixed seed for reproducible runs
+	uint64_t rndState = 88172645463325252ULL;
+	uint64_t Rnd()
+	{
+		rndState ^= rndState << 13;
+		rndState ^= rndState >> 7;
+		rndState ^= rndState << 17;
+		return rndState;
+	}
+
+	// |exact| - |result|, the reciprocal division never rounds above the exact quotient
+	template <DivMode mode>
+	int64_t DivError32(int32_t a, int32_t b)
+	{
+		int64_t exact = ((int64_t)a << 16) / b;
+		int64_t result = FixDivRcp<16, mode>(a, b);
+		return (exact < 0) ? result - exact : exact - result;
+	}
+}
+
+MTEST_GROUP(FpRcpDivisionTests)
+{
+	MTEST(Fp32fExactSameAsFixDivTest)
+	{
+		for(int i = 0; i < 100000; i++)
+		{
+			int32_t a = (int32_t)Rnd() >> (Rnd() % 32);
+			int32_t b = (int32_t)Rnd() >> (Rnd() % 32);
+			if(b == 0)
+				continue;
+			int64_t exact = ((int64_t)a << 16) / b;
+			if(exact > INT32_MAX || exact < INT32_MIN)
+				continue;
+			CHECK_EQUAL((FixDivRcp<16, DIV_EXACT>(a, b)), fixdiv<16>(a, b));
+		}
+	}
+
+	MTEST(Fp32fAccuracyLevelsTest)
+	{
+		for(int i = 0; i < 100000; i++)
+		{
+			int32_t a = (int32_t)Rnd() >> (Rnd() % 32);
+			int32_t b = (int32_t)Rnd() >> (Rnd() % 32);
+			if(b == 0)
+				continue;
+			int64_t exact = ((int64_t)a << 16) / b;
+			if(exact > INT32_MAX || exact < INT32_MIN)
+				continue;
+			int64_t absExact = (exact < 0) ? -exact : exact;
+			int64_t err1 = DivError32<DIV_NR1>(a, b);
+			int64_t err2 = DivError32<DIV_NR2>(a, b);
+			int64_t err3 = DivError32<DIV_NR3>(a, b);
+			CHECK(err1 >= 0 && err1 <= (absExact >> 8) + 1);
+			CHECK(err2 >= 0 && err2 <= (absExact >> 16) + 1);
+			CHECK(err3 >= 0 && err3 <= 5);
+		}
+	}
+
+	MTEST(Fp32fSaturateTest)
+	{
+		CHECK_EQUAL(FixDivRcp<16>(1 << 30, 1), INT32_MAX);
+		CHECK_EQUAL(FixDivRcp<16>(-(1 << 30), 1), INT32_MIN);
+		CHECK_EQUAL(FixDivRcp<16>(1, 0), INT32_MAX);
+	}
+
+	MTEST(Fp32fOperatorTest)
+	{
+		Fp32f<12> fp1(10.5);
+		Fp32f<12> fp2(-2.0);
+		fp1 /= fp2;
+		CHECK_EQUAL((double)fp1, -5.25);
+	}
+
+	MTEST(Fp64fExactSameAsFixDivTest)
+	{
+		for(int i = 0; i < 100000; i++)
+		{
+			// a << 32 must fit
+			int64_t a = (int64_t)Rnd() >> (32 + Rnd() % 32);
+			int64_t b = (int64_t)Rnd() >> (Rnd() % 64);
+			if(b == 0)
+				continue;
+			CHECK_EQUAL((FixDivRcp<32, DIV_EXACT>(a, b)), FixDiv<32>(a, b));
+		}
+	}
+
+	MTEST(Fp64fAccuracyLevelsTest)
+	{
+		for(int i = 0; i < 100000; i++)
+		{
+			int64_t a = (int64_t)Rnd() >> (32 + Rnd() % 32);
+			int64_t b = (int64_t)Rnd() >> (Rnd() % 64);
+			if(b == 0)
+				continue;
+			int64_t exact = FixDiv<32>(a, b);
+			uint64_t absExact = (exact < 0) ? 0 - (uint64_t)exact : (uint64_t)exact;
+			int64_t r3 = FixDivRcp<32, DIV_NR3>(a, b);
+			uint64_t abs3 = (r3 < 0) ? 0 - (uint64_t)r3 : (uint64_t)r3;
+			CHECK(abs3 <= absExact && absExact - abs3 <= (absExact >> 32) + 1);
+		}
+	}
+
+	MTEST(Fp64fOperatorTest)
+	{
+		// (10.5 << 20) << 20 still fits int64_t
+		Fp64f<20> fp1(10.5);
+		Fp64f<20> fp2(-2.0);
+		fp1 /= fp2;
+		CHECK_EQUAL((double)fp1, -5.25);
+	}
+}
@@ -6,48 +6,69 @@
 
 #define ARRAY_COUNT(a) (sizeof(a)/(sizeof(a[0])))
 
+using namespace Fp::literals; // fixed point literals, e.g. 0.01_q7
+
 const uint32_t clock = 125000000LL;
+constexpr Dds::TuningWordConverter tword_conv(clock);
+constexpr Dds::FrequencyConverter freq_conv(clock);
 
 void test_math1(void);
 void test_math2(uint32_t num_test_steps);
 void test_math3(uint32_t num_test_steps);
 void test_math4(void);
+void bench_math3(uint32_t num_iterations);
+void bench_fixmul(uint32_t num_iterations);
+void bench_fixdiv(uint32_t num_iterations);
+void bench_fixfloat(uint32_t num_iterations);
+void bench_fixchars(uint32_t num_iterations);
+void bench_log(uint32_t num_iterations);
+void bench_logline(uint32_t num_iterations);
+void bench_cycles(uint8_t samples);
 
 
 void setup()
 {
-    Log.Init(LOGLEVEL, 38400L, LOG_PRINT_TS, LOG_AUTO_LN);
+    Log.Init(LOGLEVEL, 38400L, LOG_PRINT_TS, LOG_AUTO_LN, LOG_BINARY);
 } // setup
 
 void loop()
 {
-    delay(3000);
+    // wait 3 s, the binary log records go out meanwhile
+    for (uint32_t t_start = millis(); millis() - t_start < 3000;)
+        Log.Drain();
     // test_math2(100);
     test_math3(300);
+    // bench_math3(1000);
+    // bench_fixmul(1000);
+    // bench_fixdiv(1000);
+    // bench_fixfloat(1000);
+    // bench_fixchars(1000);
+    // bench_log(1000);
+    // bench_logline(100);
+    // bench_cycles(31); // tools/cycle_table.py turns the CB: lines into a table
 
-
+    // the records still in the buffer, the host run ends after the last pass
+    Log.Flush();
 } // function loop
 
+// bytes of v from the most significant one (AVR is little endian)
 void print_bin64(const char * vname, uint64_t v)
 {
-    Log.Info(F("%s: %y-%y-%y-%y-%y-%y-%y-%y"), vname,\
-        Byte8(v),Byte7(v),Byte6(v),Byte5(v),\
-        Byte4(v),Byte3(v),Byte2(v),Byte1(v));
+    Log.Dump(vname, &v, sizeof(v), LOG_DUMP_BIN | LOG_DUMP_MSB);
 }
 
 void print_bin32(const char * vname, uint32_t v)
 {
-    Log.Info(F("%s: %y-%y-%y-%y"), vname,\
-        Byte4(v),Byte3(v),Byte2(v),Byte1(v));
+    Log.Dump(vname, &v, sizeof(v), LOG_DUMP_BIN | LOG_DUMP_MSB);
 }
 
 // test scenarios
 void test_math1() {
-    Fp::Fp32s fp_test1 = Fp::Fp32s(9, 2935, 10000, 14);
-    float f_test1 = (float)fp_test1;
+    constexpr Fp::Fp32s fp_test1 = 9.2935_q14;
+    constexpr float f_test1 = (float)fp_test1;
     int32_t i_test1 = 92935L;
-    Fp::Fp32s fp_test2 = Fp::Fp32s(0, 2935, 10000, 14);
-    float f_test2 = (float)fp_test2;
+    constexpr Fp::Fp32s fp_test2 = 0.2935_q14;
+    constexpr float f_test2 = (float)fp_test2;
     int32_t i_test2 = 2935L;
     Fp::Fp32s fp_test3 = fp_test1 * fp_test2;
     float f_test3 = (float)fp_test3;
@@ -59,40 +80,40 @@ void test_math1() {
     print_bin32("UINT32_MAX", UINT32_MAX);
     print_bin32("INT32_MAX", INT32_MAX);
     print_bin32("INT32_MIN", INT32_MIN);
-    Log.Info(F("UINT32_MAX: %u, INT32_MAX: %l, INT32_MIN: %l"), UINT32_MAX, INT32_MAX, INT32_MIN);
+    LOG_INFO("UINT32_MAX: %u, INT32_MAX: %l, INT32_MIN: %l", UINT32_MAX, INT32_MAX, INT32_MIN);
 
-    Log.Info(F("!!!*******************************************!!!"));
+    LOG_INFO("!!!*******************************************!!!");
     Serial.println(f_test1);
     print_bin32("fp_test1", fp_test1.rawVal);
-    Log.Info(F("fp_test1.rawVal: %u, q: %d"), fp_test1.rawVal, fp_test1.q);
-    Log.Info(F("fp_test1 to int32_t: %u"), int32_t(fp_test1));
-    Log.Info(F("fp_test1.ipart: %u"), fp_test1.ipart());
+    LOG_INFO("fp_test1.rawVal: %l, q: %d", fp_test1.rawVal, fp_test1.q);
+    LOG_INFO("fp_test1 to int32_t: %l", int32_t(fp_test1));
+    LOG_INFO("fp_test1.ipart: %l", fp_test1.ipart());
     print_bin32("fp_test1.ipart", fp_test1.ipart());
-    Log.Info(F("fp_test1.fpart: %u"), fp_test1.fpart());
+    LOG_INFO("fp_test1.fpart: %u", fp_test1.fpart());
     print_bin32("fp_test1.fpart", fp_test1.fpart());
-    Log.Info(F("fp_test1 in 2 parts: %u+%u/%u"), fp_test1.ipart(), fp_test1.fpart(), fp_test1.fpart_divider());
+    LOG_INFO("fp_test1 in 2 parts: %l+%u/%u", fp_test1.ipart(), fp_test1.fpart(), fp_test1.fpart_divider());
 
-    Log.Info(F("*************************************************"));
+    LOG_INFO("*************************************************");
     Serial.println(f_test2);
     print_bin32("fp_test2", fp_test2.rawVal);
-    Log.Info(F("fp_test2.rawVal: %u, q: %d"), fp_test2.rawVal, fp_test2.q);
-    Log.Info(F("fp_test2 to int32_t: %u"), int32_t(fp_test2));
-    Log.Info(F("fp_test2.ipart: %u"), fp_test2.ipart());
+    LOG_INFO("fp_test2.rawVal: %l, q: %d", fp_test2.rawVal, fp_test2.q);
+    LOG_INFO("fp_test2 to int32_t: %l", int32_t(fp_test2));
+    LOG_INFO("fp_test2.ipart: %l", fp_test2.ipart());
     print_bin32("fp_test2.ipart", fp_test2.ipart());
-    Log.Info(F("fp_test2.fpart: %u"), fp_test2.fpart());
+    LOG_INFO("fp_test2.fpart: %u", fp_test2.fpart());
     print_bin32("fp_test2.fpart", fp_test2.fpart());
-    Log.Info(F("fp_test2 in 2 parts: %u+%u/%u"), fp_test2.ipart(), fp_test2.fpart(), fp_test2.fpart_divider());
+    LOG_INFO("fp_test2 in 2 parts: %l+%u/%u", fp_test2.ipart(), fp_test2.fpart(), fp_test2.fpart_divider());
 
-    Log.Info(F("*************************************************"));
+    LOG_INFO("*************************************************");
     Serial.println(f_test3);
     print_bin32("fp_test3", fp_test3.rawVal);
-    Log.Info(F("fp_test3.rawVal: %u, q: %d"), fp_test3.rawVal, fp_test3.q);
-    Log.Info(F("fp_test3 to int32_t: %u"), int32_t(fp_test3));
-    Log.Info(F("fp_test3.ipart: %u"), fp_test3.ipart());
+    LOG_INFO("fp_test3.rawVal: %l, q: %d", fp_test3.rawVal, fp_test3.q);
+    LOG_INFO("fp_test3 to int32_t: %l", int32_t(fp_test3));
+    LOG_INFO("fp_test3.ipart: %l", fp_test3.ipart());
     print_bin32("fp_test3.ipart", fp_test3.ipart());
-    Log.Info(F("fp_test3.fpart: %u"), fp_test3.fpart());
+    LOG_INFO("fp_test3.fpart: %u", fp_test3.fpart());
     print_bin32("fp_test3.fpart", fp_test3.fpart());
-    Log.Info(F("fp_test3 in 2 parts: %u+%u/%u"), fp_test3.ipart(), fp_test3.fpart(), fp_test3.fpart_divider());
+    LOG_INFO("fp_test3 in 2 parts: %l+%u/%u", fp_test3.ipart(), fp_test3.fpart(), fp_test3.fpart_divider());
 
     Serial.println(f_test1 * f_test2);
     Serial.println(i_test1);
@@ -102,37 +123,35 @@ void test_math1() {
 
 void test_math2(uint32_t num_test_steps) {
     int32_t freq_test[] = {0, 1000, 9995, 50000, 100000, 150995, 1000000, 1499995, 10000000, 19999995};
-    Log.Info(F("ITERATION: STEP: FREQ(FL): TWORD(INT): FREQ(100INT): TWORD(INT/100): FREQ(FP): FREQ(FP->F)"));
+    LOG_INFO("ITERATION: STEP: FREQ(FL): TWORD(INT): FREQ(100INT): TWORD(INT/100): FREQ(FP): FREQ(FP->F)");
     float freqf;
     uint32_t tword_freqf;
     uint32_t freq100i;
     uint32_t tword_freq100i;
     //Fp::Fp32s fp2pow32 = Fp::Fp32s(UINT32_MAX, 0);
-    Fp::Fp32s freqfp_step = Fp::Fp32s(0, 1, 100, 7); // 0.01, 7bits precision
+    constexpr Fp::Fp32s freqfp_step = 0.01_q7; // 7bits precision
     //Fp::Fp32s tword_freqfp = Fp::Fp32s(0, 2);  // init as 0, 2 bits presision tword = (0; ~1030792151)
 
     char fbuf1[13];
-    char fbuf2[13];
     char fbuf3[13];
     int count = ARRAY_COUNT(freq_test);
     for (int t = 0;  t < count; t++) {
         freqf = (float)freq_test[t];
         freq100i = 100 * freq_test[t];
         Fp::Fp32s freqfp = Fp::Fp32s(freq_test[t], 7); //7 bits precizion ~ 2 decimal places after point
-        for (size_t i = 0; i < num_test_steps; i++) {
+        for (uint32_t i = 0; i < num_test_steps; i++) {
             // float calc
             tword_freqf = freqf * UINT32_MAX / clock;
             dtostrf(freqf, 0, 2, fbuf1);
             // int calc
-            tword_freq100i = (((uint64_t)freq100i << 32) / clock) / 100L;
+            tword_freq100i = tword_conv.from_hz100(freq100i); // == (((uint64_t)freq100i << 32) / clock) / 100L
             // fixed point calc
             //Fp::Fp32s tword_freqfp = Fp::Fp32s(0, 2935, 10000, 14);
-            sprintf(fbuf2, "%02lu", freqfp.fpart());
             dtostrf((float)freqfp, 0, 2, fbuf3);
 
-            Log.Info(F("%u: \t%d: \t%s: \t%u: \t%u: \t%u: \t%u.%s: \t%s"), \
+            LOG_INFO("%l: \t%u: \t%s: \t%u: \t%u: \t%u: \t%2q: \t%s", \
                     freq_test[t], i, fbuf1, tword_freqf, freq100i, tword_freq100i,\
-                    freqfp.ipart(), fbuf2, fbuf3);
+                    freqfp, fbuf3);
             freqf += 0.01F;
             freq100i += 1;
             freqfp += freqfp_step;
@@ -142,7 +161,7 @@ void test_math2(uint32_t num_test_steps) {
 
 void test_math3(uint32_t num_test_steps) {
     int32_t tword_test[] = {0, 34300, 343600, 1717900, 3435900, 5188300, 34359700, 51539600, 343597300, 687194700};
-    Log.Info(F("ITERATION: STEP: TWORD(INT): FREQ(F): FREQ(INT100)"));
+    LOG_INFO("ITERATION: STEP: TWORD(INT): FREQ(F): FREQ(INT100)");
     uint32_t tword;
     float freqf;
     uint32_t freq100i;
@@ -151,16 +170,469 @@ void test_math3(uint32_t num_test_steps) {
     int count = ARRAY_COUNT(tword_test);
     for (int t = 0;  t < count; t++) {
         tword = tword_test[t];
-        for (size_t i = 0; i < num_test_steps; i++) {
+        for (uint32_t i = 0; i < num_test_steps; i++) {
             // float calc
             freqf = (float)tword * (float)clock / UINT32_MAX;
             dtostrf(freqf, 0, 2, fbuf1);
-            // int calc
-            freq100i = ((uint64_t)tword * (uint64_t)clock * 100) >> 32;
+            // int calc, == ((uint64_t)tword * (uint64_t)clock * 100) >> 32
+            freq100i = freq_conv.convert(tword).hz100();
 
-            Log.Info(F("%u: \t%d: \t%u: \t%s: \t%u"),\
+            LOG_INFO("%l: \t%u: \t%u: \t%s: \t%u",\
                     tword_test[t], i, tword, fbuf1, freq100i);
             tword += 1;
         }
     }
 }
+
+// CPU cycles per call of the tword->freq conversion paths of test_math3
+// (micros() has 4 us resolution, so keep num_iterations >= 1000)
+#define CYCLES_PER_CALL(us, n) ((uint32_t)(((uint64_t)(us) * (F_CPU / 1000000L)) / (n)))
+
+void bench_math3(uint32_t num_iterations) {
+    uint32_t tword = 343597300;
+    volatile float sinkf;
+    volatile uint32_t sinki;
+    volatile uint8_t sinkc;
+    char fbuf1[13];
+    uint32_t t_start;
+
+    LOG_INFO("PATH: CYCLES/CALL");
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinkf = (float)(tword + i) * (float)clock / UINT32_MAX;
+    }
+    LOG_INFO("float: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        float freqf = (float)(tword + i) * (float)clock / UINT32_MAX;
+        dtostrf(freqf, 0, 2, fbuf1);
+    }
+    LOG_INFO("float+dtostrf: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = ((uint64_t)(tword + i) * (uint64_t)clock * 100) >> 32;
+    }
+    LOG_INFO("int100: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        Dds::Frequency f = freq_conv.convert(tword + i);
+        sinki = f.hz;
+        sinkc = f.centi;
+    }
+    LOG_INFO("freq_conv: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        freq_conv.convert(tword + i).centi_to_chars(fbuf1);
+        sinkc = fbuf1[1];
+    }
+    LOG_INFO("freq_conv+chars: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+    (void)sinkf;
+    (void)sinki;
+    (void)sinkc;
+}
+
+// Fixed-point multiply: 64-bit C expression vs the AVR mul kernel (FpMul.hpp).
+// "loop" is the cost of the loop and the volatile accesses, subtract it from the other rows.
+void bench_fixmul(uint32_t num_iterations) {
+    volatile int32_t a = 1217380;   // 74.3 in Q14
+    volatile int32_t b = -20316;    // -1.24 in Q14
+    volatile uint8_t q = 14;
+    volatile int32_t sinki;
+    uint32_t t_start;
+
+    LOG_INFO("PATH: CYCLES/CALL");
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = a + b + q;
+    }
+    LOG_INFO("loop: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = (int32_t)(((int64_t)a * (int64_t)b) >> q);
+    }
+    LOG_INFO("int64: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::mul32_shr(a, b, q);
+    }
+    LOG_INFO("mul32_shr: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = (int32_t)(((int64_t)a * (int64_t)b) >> 14);
+    }
+    LOG_INFO("int64 q14: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::mul32_shr(a, b, 14);
+    }
+    LOG_INFO("mul32_shr q14: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        Fp::Fp32s x = Fp::Fp32s::from_raw(a, q);
+        x *= Fp::Fp32s::from_raw(b, q);
+        sinki = x.rawVal;
+    }
+    LOG_INFO("Fp32s *=: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+    (void)sinki;
+}
+
+// Fixed-point division: 64-bit C expression vs the reciprocal division (FpDiv.hpp)
+// at each accuracy level. Subtract the "loop" row of bench_fixmul().
+void bench_fixdiv(uint32_t num_iterations) {
+    volatile int32_t a = 1217380;   // 74.3 in Q14
+    volatile int32_t b = -20316;    // -1.24 in Q14
+    volatile uint8_t q = 14;
+    volatile int32_t sinki;
+    uint32_t t_start;
+
+    LOG_INFO("PATH: CYCLES/CALL");
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = (int32_t)(((int64_t)a << q) / (int64_t)b);
+    }
+    LOG_INFO("int64: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::div32_shl(a, b, q, Fp::DIV_NR1);
+    }
+    LOG_INFO("div NR1: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::div32_shl(a, b, q, Fp::DIV_NR2);
+    }
+    LOG_INFO("div NR2: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::div32_shl(a, b, q, Fp::DIV_NR3);
+    }
+    LOG_INFO("div NR3: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::div32_shl(a, b, q, Fp::DIV_EXACT);
+    }
+    LOG_INFO("div exact: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+    (void)sinki;
+}
+
+// Fixed-point <-> float: soft-float division / multiplication vs the float bits
+// (FpFloat.hpp). Subtract the "loop" row of bench_fixmul().
+void bench_fixfloat(uint32_t num_iterations) {
+    volatile int32_t a = 1217380;   // 74.3 in Q14
+    volatile float f = 74.3;
+    volatile uint8_t q = 14;
+    volatile float sinkf;
+    volatile int32_t sinki;
+    char fbuf1[13];
+    uint32_t t_start;
+
+    LOG_INFO("PATH: CYCLES/CALL");
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinkf = (float)a / (float)((uint32_t)1 << q);
+    }
+    LOG_INFO("float div: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinkf = Fp::detail::fix32_to_float_bits(a, q);
+    }
+    LOG_INFO("float bits: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        dtostrf((float)a / (float)((uint32_t)1 << q), 0, 2, fbuf1);
+    }
+    LOG_INFO("div+dtostrf: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        dtostrf(Fp::detail::fix32_to_float_bits(a, q), 0, 2, fbuf1);
+    }
+    LOG_INFO("bits+dtostrf: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = (int32_t)(f * (float)((uint32_t)1 << q));
+    }
+    LOG_INFO("float mul: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sinki = Fp::detail::float_to_fix32_bits(f, q, Fp::ROUND_TRUNC);
+    }
+    LOG_INFO("fix bits: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+    (void)sinkf;
+    (void)sinki;
+}
+
+// Fixed-point to text: dtostrf of the float, ipart + sprintf of fpart and
+// to_chars (FpChars.hpp). Subtract the "loop" row of bench_fixmul().
+void bench_fixchars(uint32_t num_iterations) {
+    volatile int32_t a = 1217380;   // 74.3 in Q14
+    volatile uint8_t q = 14;
+    volatile char sinkc;
+    char fbuf1[13];
+    uint32_t t_start;
+
+    LOG_INFO("PATH: CYCLES/CALL");
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        dtostrf((float)Fp::Fp32s::from_raw(a, q), 0, 2, fbuf1);
+        sinkc = fbuf1[1];
+    }
+    LOG_INFO("dtostrf: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        Fp::Fp32s fp = Fp::Fp32s::from_raw(a, q);
+        sinkc = (char)fp.ipart();
+        sprintf(fbuf1, "%02lu", (unsigned long)fp.fpart());
+        sinkc = fbuf1[1];
+    }
+    LOG_INFO("fpart+sprintf: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        Fp::Fp32s::from_raw(a, q).to_chars(fbuf1, 2);
+        sinkc = fbuf1[1];
+    }
+    LOG_INFO("to_chars: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    // the other way, as for a serial frequency command
+    static const char cmd[] = "7000000.25";
+    volatile int32_t sink32;
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sink32 = Fp::Fp32s(atof(cmd), 7).rawVal;
+    }
+    LOG_INFO("atof: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        sink32 = Fp::Fp32s::from_chars(cmd, sizeof(cmd) - 1, 7).rawVal;
+    }
+    LOG_INFO("from_chars: \t%u", CYCLES_PER_CALL(micros() - t_start, num_iterations));
+    (void)sinkc;
+    (void)sink32;
+}
+
+// CPU cycles per disabled log call site, a test_math3 like line: filtered at
+// runtime by the level set by Log.SetLevel vs removed at compile time by LOGLEVEL
+// (LOG_VERBOSE is removed as long as LOGLEVEL < LOG_LEVEL_VERBOSE)
+void bench_log(uint32_t num_iterations) {
+    volatile uint32_t tword = 343597300;
+    uint32_t t_start;
+
+    LOG_INFO("PATH: CYCLES/CALL (LOGLEVEL %d)", LOGLEVEL);
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        tword = tword + 1;
+    }
+    uint32_t empty = micros() - t_start;
+    LOG_INFO("empty loop: \t%u", CYCLES_PER_CALL(empty, num_iterations));
+
+    Log.SetLevel(LOG_LEVEL_ERRORS);
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        tword = tword + 1;
+        LOG_DEBUG("%u: \t%u", (uint32_t)tword, freq_conv.convert(tword).hz100());
+    }
+    uint32_t t_runtime = micros() - t_start;
+    Log.SetLevel(LOGLEVEL);
+    LOG_INFO("runtime level: \t%u", CYCLES_PER_CALL(t_runtime - empty, num_iterations));
+
+    t_start = micros();
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        tword = tword + 1;
+        LOG_VERBOSE("%u: \t%u", (uint32_t)tword, freq_conv.convert(tword).hz100());
+    }
+    uint32_t t_compiled = micros() - t_start;
+    LOG_INFO("LOGLEVEL: \t%u", CYCLES_PER_CALL(t_compiled - empty, num_iterations));
+}
+
+// a Serial.print per character, as Logging wrote text lines before
+static void print_chars(PGM_P p) {
+    for (char c = pgm_read_byte(p); c != 0; c = pgm_read_byte(++p))
+        Serial.print(c);
+}
+
+// CPU cycles per logged text line, the test_math3 line without time stamp
+// (the UART is emptied first, so Serial only buffers the line): the former
+// per character Serial.print calls vs the line buffer and one Serial.write,
+// then the 64-bit tword * clock * 100 product as print_bin64 bits vs %U
+void bench_logline(uint32_t num_iterations) {
+    uint32_t tword = 343597300;
+    const char *fbuf1 = "79999.99";
+    uint32_t t_print = 0;
+    uint32_t t_line = 0;
+    uint32_t t_bytes = 0;
+    uint32_t t_u64 = 0;
+    uint32_t t_start;
+
+    Log.SetMode(LOG_TS_NONE, LOG_AUTO_LN, false);
+    for (uint32_t i = 0; i < num_iterations; i++) {
+        Serial.flush();
+        t_start = micros();
+        Serial.print((long)tword, DEC);
+        print_chars(PSTR(": \t"));
+        Serial.print(i, DEC);
+        print_chars(PSTR(": \t"));
+        Serial.print(tword, DEC);
+        print_chars(PSTR(": \t"));
+        Serial.print(fbuf1);
+        print_chars(PSTR(": \t"));
+        Serial.print(tword / 43, DEC);
+        Serial.println();
+        t_print += micros() - t_start;
+
+        Serial.flush();
+        t_start = micros();
+        LOG_INFO("%l: \t%u: \t%u: \t%s: \t%u", (int32_t)tword, i, tword, fbuf1, tword / 43);
+        t_line += micros() - t_start;
+
+        uint64_t prod = (uint64_t)(tword + i) * (uint64_t)clock * 100;
+        Serial.flush();
+        t_start = micros();
+        print_bin64("prod", prod);
+        t_bytes += micros() - t_start;
+
+        Serial.flush();
+        t_start = micros();
+        LOG_INFO("prod: %U", prod);
+        t_u64 += micros() - t_start;
+    }
+    Serial.flush();
+    Log.SetMode(LOG_PRINT_TS, LOG_AUTO_LN, LOG_BINARY);
+    LOG_INFO("PATH: CYCLES/LINE");
+    LOG_INFO("print per char: \t%u", CYCLES_PER_CALL(t_print, num_iterations));
+    LOG_INFO("line write: \t%u", CYCLES_PER_CALL(t_line, num_iterations));
+    LOG_INFO("u64 Dump BIN: \t%u", CYCLES_PER_CALL(t_bytes, num_iterations));
+    LOG_INFO("u64 %%U: \t%u", CYCLES_PER_CALL(t_u64, num_iterations));
+}
+
+// Operands of the bench_cycles() functions, sample i uses [i & 7]: Q14 numbers
+// of both signs and magnitudes, b not 0 and the quotients fit in Q14
+static const int32_t cb_a[8] = {1217380, -20316, 16384, -1638400, 81920000, -3, 2049, 409600};
+static const int32_t cb_b[8] = {-20316, 1217380, 1640, 16384, -49152, 5000000, 30000, -1638400};
+static const float cb_f[8] = {74.3f, -1.24f, 1.0f, -100.0f, 5000.0f, -0.0002f, 0.125f, 25.0f};
+static const char *const cb_text[8] = {
+    "74.3", "-1.24", "7000000.25", "0.01", "-100", "9999999.99", "3", "12345.678"
+};
+static const uint32_t cb_tword[8] = {0, 34300, 343600, 1717900, 3435900, 5188300, 34359700, 687194700};
+static const uint32_t cb_freq100[8] = {0, 100000, 999500, 5000000, 10000000, 15099500, 100000000, 1999999500};
+static const int32_t cb_freq_q7[8] = {0, 128000L, 1279360L, 6400000L, 12800000L, 19327360L, 128000000L, 1280000000L};
+static volatile int32_t cb_sink32;
+static volatile float cb_sinkf;
+static volatile char cb_sinkc;
+static char cb_buf[24];
+
+#define CB_A(i) Fp::Fp32s::from_raw(cb_a[(i) & 7], 14)
+#define CB_B(i) Fp::Fp32s::from_raw(cb_b[(i) & 7], 14)
+
+// operand loads and result store alone, part of every row below
+static void cb_ldst(uint8_t i) { cb_sink32 = cb_a[i & 7] + cb_b[i & 7]; }
+static void cb_add(uint8_t i) { cb_sink32 = (CB_A(i) + CB_B(i)).rawVal; }
+static void cb_sub(uint8_t i) { cb_sink32 = (CB_A(i) - CB_B(i)).rawVal; }
+static void cb_mul(uint8_t i) { cb_sink32 = (CB_A(i) * CB_B(i)).rawVal; }
+static void cb_div(uint8_t i) { cb_sink32 = (CB_A(i) / CB_B(i)).rawVal; }
+static void cb_mod(uint8_t i) { cb_sink32 = (CB_A(i) % CB_B(i)).rawVal; }
+static void cb_lt(uint8_t i) { cb_sink32 = CB_A(i) < CB_B(i); }
+static void cb_eq(uint8_t i) { cb_sink32 = CB_A(i) == CB_B(i); }
+// b in Q7: the q > r.q paths of the operators
+static void cb_add_q7(uint8_t i) { cb_sink32 = (CB_A(i) + Fp::Fp32s::from_raw(cb_b[i & 7] >> 7, 7)).rawVal; }
+static void cb_mul_q7(uint8_t i) { cb_sink32 = (CB_A(i) * Fp::Fp32s::from_raw(cb_b[i & 7] >> 7, 7)).rawVal; }
+static void cb_mul_i64(uint8_t i) { cb_sink32 = (int32_t)(((int64_t)cb_a[i & 7] * cb_b[i & 7]) >> 14); }
+static void cb_mul32_shr(uint8_t i) { cb_sink32 = Fp::detail::mul32_shr(cb_a[i & 7], cb_b[i & 7], 14); }
+static void cb_div_i64(uint8_t i) { cb_sink32 = (int32_t)(((int64_t)cb_a[i & 7] << 14) / cb_b[i & 7]); }
+static void cb_div_nr1(uint8_t i) { cb_sink32 = Fp::detail::div32_shl(cb_a[i & 7], cb_b[i & 7], 14, Fp::DIV_NR1); }
+static void cb_div_nr2(uint8_t i) { cb_sink32 = Fp::detail::div32_shl(cb_a[i & 7], cb_b[i & 7], 14, Fp::DIV_NR2); }
+static void cb_div_nr3(uint8_t i) { cb_sink32 = Fp::detail::div32_shl(cb_a[i & 7], cb_b[i & 7], 14, Fp::DIV_NR3); }
+static void cb_div_exact(uint8_t i) { cb_sink32 = Fp::detail::div32_shl(cb_a[i & 7], cb_b[i & 7], 14, Fp::DIV_EXACT); }
+static void cb_ipart(uint8_t i) { cb_sink32 = CB_A(i).ipart(); }
+static void cb_fpart(uint8_t i) { cb_sink32 = CB_A(i).fpart(); }
+static void cb_to_float(uint8_t i) { cb_sinkf = (float)CB_A(i); }
+static void cb_to_float_div(uint8_t i) { cb_sinkf = (float)cb_a[i & 7] / (float)((uint32_t)1 << 14); }
+static void cb_from_float(uint8_t i) { cb_sink32 = Fp::Fp32s::from_float(cb_f[i & 7], 14).rawVal; }
+static void cb_from_float_mul(uint8_t i) { cb_sink32 = (int32_t)(cb_f[i & 7] * (float)((uint32_t)1 << 14)); }
+static void cb_to_chars(uint8_t i) { CB_A(i).to_chars(cb_buf, 2); cb_sinkc = cb_buf[1]; }
+static void cb_dtostrf(uint8_t i) { dtostrf((float)CB_A(i), 0, 2, cb_buf); cb_sinkc = cb_buf[1]; }
+static void cb_from_chars(uint8_t i)
+{
+    const char *s = cb_text[i & 7];
+    cb_sink32 = Fp::Fp32s::from_chars(s, strlen(s), 7).rawVal;
+}
+static void cb_atof(uint8_t i) { cb_sink32 = Fp::Fp32s(atof(cb_text[i & 7]), 7).rawVal; }
+static void cb_freq_conv(uint8_t i) { cb_sink32 = freq_conv.convert(cb_tword[i & 7]).hz100(); }
+static void cb_freq_float(uint8_t i) { cb_sinkf = (float)cb_tword[i & 7] * (float)clock / UINT32_MAX; }
+static void cb_freq_chars(uint8_t i) { freq_conv.convert(cb_tword[i & 7]).centi_to_chars(cb_buf); cb_sinkc = cb_buf[1]; }
+static void cb_tword_hz100(uint8_t i) { cb_sink32 = tword_conv.from_hz100(cb_freq100[i & 7]); }
+static void cb_tword_i64(uint8_t i) { cb_sink32 = (((uint64_t)cb_freq100[i & 7] << 32) / clock) / 100; }
+static void cb_tword_fp(uint8_t i) { cb_sink32 = tword_conv.from_fp(Fp::Fp32s::from_raw(cb_freq_q7[i & 7], 7)); }
+
+static void bench_cycles_row(const Bench::CycleTimer &timer, PGM_P name, Bench::CycleFn fn, uint8_t samples) {
+    char buf[20];
+    strncpy_P(buf, name, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = 0;
+    Bench::CycleStats st = timer.run(fn, samples);
+    LOG_INFO("CB: %s\t%u\t%u\t%u", buf, st.min, st.median, st.max);
+}
+
+#define CYCLE_ROW(name, fn) bench_cycles_row(timer, PSTR(name), fn, samples)
+
+// CPU cycles of single calls of the fixed-point operations, conversions and
+// formatting from Timer1 (CycleBench.hpp), min / median / max of samples
+// calls on 8 operands, the call overhead subtracted. One line per row,
+// "CB: name <tab> min <tab> median <tab> max", after "CB CLOCK: ticks/s <tab>
+// overhead <tab> samples" (tools/cycle_table.py)
+void bench_cycles(uint8_t samples) {
+    Bench::CycleTimer timer;
+    timer.begin();
+    LOG_INFO("CB CLOCK: %u\t%u\t%u", Bench::CycleTimer::tick_hz(), timer.overhead(), (uint32_t)samples);
+    CYCLE_ROW("ld/st", cb_ldst);
+    CYCLE_ROW("fp32s +", cb_add);
+    CYCLE_ROW("fp32s -", cb_sub);
+    CYCLE_ROW("fp32s *", cb_mul);
+    CYCLE_ROW("fp32s /", cb_div);
+    CYCLE_ROW("fp32s %", cb_mod);
+    CYCLE_ROW("fp32s <", cb_lt);
+    CYCLE_ROW("fp32s ==", cb_eq);
+    CYCLE_ROW("fp32s + q7", cb_add_q7);
+    CYCLE_ROW("fp32s * q7", cb_mul_q7);
+    CYCLE_ROW("mul int64", cb_mul_i64);
+    CYCLE_ROW("mul32_shr", cb_mul32_shr);
+    CYCLE_ROW("div int64", cb_div_i64);
+    CYCLE_ROW("div NR1", cb_div_nr1);
+    CYCLE_ROW("div NR2", cb_div_nr2);
+    CYCLE_ROW("div NR3", cb_div_nr3);
+    CYCLE_ROW("div exact", cb_div_exact);
+    CYCLE_ROW("ipart", cb_ipart);
+    CYCLE_ROW("fpart", cb_fpart);
+    CYCLE_ROW("to float", cb_to_float);
+    CYCLE_ROW("to float div", cb_to_float_div);
+    CYCLE_ROW("from_float", cb_from_float);
+    CYCLE_ROW("from float mul", cb_from_float_mul);
+    CYCLE_ROW("to_chars", cb_to_chars);
+    CYCLE_ROW("dtostrf", cb_dtostrf);
+    CYCLE_ROW("from_chars", cb_from_chars);
+    CYCLE_ROW("atof", cb_atof);
+    CYCLE_ROW("freq_conv", cb_freq_conv);
+    CYCLE_ROW("freq float", cb_freq_float);
+    CYCLE_ROW("centi_to_chars", cb_freq_chars);
+    CYCLE_ROW("from_hz100", cb_tword_hz100);
+    CYCLE_ROW("tword int64", cb_tword_i64);
+    CYCLE_ROW("from_fp", cb_tword_fp);
+    timer.end();
+}
@@ -4,12 +4,20 @@
 */
 #include <Arduino.h>
 #include <inttypes.h>
+
+// before Logging.h: calls above LOGLEVEL are removed at compile time
+#ifndef LOGLEVEL
+#define LOGLEVEL LOG_LEVEL_DEBUG // see Logging.h for options
+#endif
 #include <Logging.h>
 #include <Fp32s.hpp>
+#include <TuningWordConverter.hpp>
+#include <FrequencyConverter.hpp>
+#include <CycleBench.hpp>
 
-#define LOGLEVEL LOG_LEVEL_DEBUG // see Logging.h for options
-#define LOG_PRINT_TS true  // print time stamp in logging
+#define LOG_PRINT_TS LOG_TS_MILLIS // time stamp in logging, LOG_TS_MICROS | LOG_TS_DELTA gives the time per step
 #define LOG_AUTO_LN  true  // print auto LN (CR) after each call
+#define LOG_BINARY   false // binary records drained in loop(), decode with tools/log_decode.py
 
 #define Byte1(w) ((uint8_t) ((w) & 0xff))
 #define Byte2(w) ((uint8_t) ((w) >> 8))
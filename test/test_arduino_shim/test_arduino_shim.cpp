@@ -0,0 +1,94 @@
+/*
+    Host test of the Arduino shim (lib/arduino_shim): text as on the board
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <Arduino.h>
+
+// Print into a string
+class PrintBuf : public Print {
+public:
+    char buf[64];
+    size_t len;
+    PrintBuf() : len(0) { buf[0] = 0; }
+    size_t write(uint8_t b)
+    {
+        if (len + 1 >= sizeof(buf))
+            return 0;
+        buf[len++] = (char)b;
+        buf[len] = 0;
+        return 1;
+    }
+    using Print::write;
+};
+
+static const char *dtostr(double v, signed char width, unsigned char prec)
+{
+    static char s[32];
+    return dtostrf(v, width, prec, s);
+}
+
+// values from the captures in .log/ (avr-libc output)
+void test_dtostrf_board_text(void)
+{
+    TEST_ASSERT_EQUAL_STRING("0.00", dtostr(0.0f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("0.03", dtostr(1.0f * 125000000.0f / 4294967295.0f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("0.01", dtostr(0.0078125f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("49999.63", dtostr(49999.625f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("100000.13", dtostr(100000.125f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("1000007.60", dtostr(1000007.625f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("19999996.00", dtostr(19999995.0f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("20000008.00", dtostr(20000008.0f, 0, 2));
+}
+
+void test_dtostrf_rounding(void)
+{
+    TEST_ASSERT_EQUAL_STRING("10.00", dtostr(9.999f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("0.00", dtostr(0.004f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("-2.50", dtostr(-2.5f, 0, 2));
+    TEST_ASSERT_EQUAL_STRING("3", dtostr(2.5f, 0, 0));
+    TEST_ASSERT_EQUAL_STRING("1.2345679", dtostr(1.23456789f, 0, 7));
+}
+
+void test_dtostrf_width(void)
+{
+    TEST_ASSERT_EQUAL_STRING("  1.50", dtostr(1.5f, 6, 2));
+    TEST_ASSERT_EQUAL_STRING("1.50  ", dtostr(1.5f, -6, 2));
+    TEST_ASSERT_EQUAL_STRING("1.50", dtostr(1.5f, 2, 2));
+}
+
+void test_print_numbers(void)
+{
+    PrintBuf p;
+    p.print(-92935L);
+    p.print(' ');
+    p.print(255, HEX);
+    p.print(' ');
+    p.print((uint8_t)5, BIN);
+    p.print(' ');
+    p.print(4294967295UL);
+    p.println();
+    TEST_ASSERT_EQUAL_STRING("-92935 FF 101 4294967295\r\n", p.buf);
+}
+
+void test_print_float(void)
+{
+    PrintBuf p;
+    p.println(9.2935f);
+    p.print(-0.005f, 3);
+    p.print(' ');
+    p.print(5e9f);
+    TEST_ASSERT_EQUAL_STRING("9.29\r\n-0.005 ovf", p.buf);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_dtostrf_board_text);
+    RUN_TEST(test_dtostrf_rounding);
+    RUN_TEST(test_dtostrf_width);
+    RUN_TEST(test_print_numbers);
+    RUN_TEST(test_print_float);
+    UNITY_END();
+    return 0;
+}
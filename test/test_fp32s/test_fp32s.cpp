@@ -0,0 +1,60 @@
+/*
+    Host test of the Fp32s fork (lib/MFixedPoint)
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <Fp32s.hpp>
+
+using namespace Fp::literals;
+
+// constants are built by the compiler, the build fails if they are not constant expressions
+static constexpr Fp::Fp32s freq_step = Fp::Fp32s(0, 1, 100, 7);
+static constexpr Fp::Fp32s fp_neg = Fp::Fp32s((int32_t)-3, 7);
+static constexpr Fp::Fp32s fp_dbl = Fp::Fp32s(-2.5, 12);
+static constexpr Fp::Fp32s fp_parts = Fp::Fp32s(9, 2935, 10000, 14);
+static_assert(freq_step.rawVal == 1 && freq_step.q == 7 && freq_step.qd == 2, "Fp32s(0, 1, 100, 7)");
+static_assert(fp_neg.rawVal == -384, "Fp32s(-3, 7)");
+static_assert(fp_dbl.rawVal == -10240, "Fp32s(-2.5, 12)");
+static_assert(fp_parts.ipart() == 9 && fp_parts.fpart() == 2935, "Fp32s(9, 2935, 10000, 14)");
+static_assert((float)fp_dbl == -2.5f, "(float)Fp32s(-2.5, 12)");
+
+// literals are rounded to nearest, out of range literals fail the build
+static_assert((0.01_q7).rawVal == freq_step.rawVal && (0.01_q7).q == 7, "0.01_q7");
+static_assert((125e6_q0).rawVal == 125000000, "125e6_q0");
+static_assert((9.2935_q14).rawVal == 152265, "9.2935_q14");
+static_assert((-3_q7).rawVal == fp_neg.rawVal, "-3_q7");
+static_assert((1.5e-3_q16).rawVal == 98, "1.5e-3_q16");
+static_assert((0.999999999_q31).rawVal == 2147483646, "0.999999999_q31");
+static_assert((16777215.99_q7).rawVal == 2147483647, "16777215.99_q7");
+
+void test_constexpr_same_as_runtime(void)
+{
+    volatile int32_t ipart = 9;
+    volatile uint32_t fpart_i = 2935;
+    Fp::Fp32s fp = Fp::Fp32s((int32_t)ipart, (uint32_t)fpart_i, 10000, 14);
+    TEST_ASSERT_EQUAL_INT32(fp_parts.rawVal, fp.rawVal);
+    TEST_ASSERT_EQUAL_UINT32(fp_parts.fpart(), fp.fpart());
+
+    volatile int32_t neg = -3;
+    fp = Fp::Fp32s((int32_t)neg, 7);
+    TEST_ASSERT_EQUAL_INT32(fp_neg.rawVal, fp.rawVal);
+}
+
+void test_literal(void)
+{
+    Fp::Fp32s fp = 3.25_q8;
+    TEST_ASSERT_EQUAL_INT32(832, fp.rawVal);
+    TEST_ASSERT_EQUAL_UINT8(8, fp.q);
+    TEST_ASSERT_EQUAL_UINT8(2, fp.qd);
+    fp = -fp;
+    TEST_ASSERT_EQUAL_INT32(-832, fp.rawVal);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_constexpr_same_as_runtime);
+    RUN_TEST(test_literal);
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+    Host test of the fixed-point to decimal text conversion (lib/MFixedPoint/FpChars.hpp)
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <Fp32s.hpp>
+#include "../test_rnd.h"
+
+// exact reference: round(|raw| * 10^digits / 2^q) half up, printed as an integer
+static void reference(char *buf, bool neg, unsigned __int128 mag, uint8_t q, uint8_t digits)
+{
+    unsigned __int128 scaled = mag;
+    for (uint8_t i = 0; i < digits; i++)
+        scaled *= 10;
+    if (q != 0)
+        scaled = (scaled + ((unsigned __int128)1 << (q - 1))) >> q;
+    char rev[48];
+    uint8_t n = 0;
+    do {
+        rev[n++] = (char)('0' + (int)(scaled % 10));
+        scaled /= 10;
+    } while (scaled != 0 || n <= digits);
+    uint8_t pos = 0;
+    if (neg)
+        buf[pos++] = '-';
+    while (n != 0) {
+        buf[pos++] = rev[--n];
+        if (n == digits && digits != 0)
+            buf[pos++] = '.';
+    }
+    buf[pos] = '\0';
+}
+
+static void check32(int32_t raw, uint8_t q, uint8_t digits)
+{
+    char expected[48];
+    char result[48];
+    uint32_t mag = (raw < 0) ? 0 - (uint32_t)raw : (uint32_t)raw;
+    reference(expected, raw < 0, mag, q, digits);
+    uint8_t len = Fp::detail::fix32_to_chars(result, raw, q, digits);
+    TEST_ASSERT_EQUAL_STRING(expected, result);
+    TEST_ASSERT_EQUAL_UINT8(strlen(expected), len);
+}
+
+static void check64(int64_t raw, uint8_t p, uint8_t digits)
+{
+    char expected[48];
+    char result[48];
+    uint64_t mag = (raw < 0) ? 0 - (uint64_t)raw : (uint64_t)raw;
+    reference(expected, raw < 0, mag, p, digits);
+    uint8_t len = Fp::detail::fix64_to_chars(result, raw, p, digits);
+    TEST_ASSERT_EQUAL_STRING(expected, result);
+    TEST_ASSERT_EQUAL_UINT8(strlen(expected), len);
+}
+
+void test_div10(void)
+{
+    static const uint32_t edge32[] = {0, 9, 10, 11, 99, 100, 0x7fffffffUL, 0xfffffff9UL, 0xffffffffUL};
+    for (uint8_t i = 0; i < sizeof(edge32) / sizeof(edge32[0]); i++)
+        TEST_ASSERT_EQUAL_UINT32(edge32[i] / 10, Fp::detail::div10_u32(edge32[i]));
+    for (uint32_t n = 0; n < 1000000; n++) {
+        uint32_t x = rnd();
+        uint64_t y = ((uint64_t)rnd() << 32) | rnd();
+        TEST_ASSERT_EQUAL_UINT32(x / 10, Fp::detail::div10_u32(x));
+        TEST_ASSERT_TRUE(y / 10 == Fp::detail::div10_u64(y));
+    }
+    TEST_ASSERT_TRUE(0xffffffffffffffffULL / 10 == Fp::detail::div10_u64(0xffffffffffffffffULL));
+}
+
+void test_edges(void)
+{
+    static const int32_t edge[] = {0, 1, -1, 127, 128, 129, 0x7fffffffL, -0x7fffffffL - 1};
+    for (uint8_t q = 0; q <= 32; q++) {
+        for (uint8_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+            for (uint8_t digits = 0; digits <= 12; digits++)
+                check32(edge[i], q, digits);
+        }
+    }
+}
+
+void test_carry(void)
+{
+    // 0.996 -> "1.00", 9.9999 -> "10.00", -0.5 -> "-1"
+    check32(255, 8, 2);
+    check32(0x9ffff, 16, 2);
+    check32(-(1 << 7), 8, 0);
+    char buf[16];
+    Fp::detail::fix32_to_chars(buf, 0x9ffff, 16, 2);
+    TEST_ASSERT_EQUAL_STRING("10.00", buf);
+    Fp::detail::fix32_to_chars(buf, -(1 << 7), 8, 0);
+    TEST_ASSERT_EQUAL_STRING("-1", buf);
+}
+
+void test_random(void)
+{
+    for (uint32_t n = 0; n < 300000; n++) {
+        check32((int32_t)rnd() >> (rnd() & 31), rnd() % 33, rnd() % 11);
+        int64_t raw64 = (int64_t)(((uint64_t)rnd() << 32) | rnd()) >> (rnd() & 63);
+        check64(raw64, rnd() % 64, rnd() % 20);
+    }
+}
+
+void test_to_chars(void)
+{
+    char buf[16];
+    // the test_math2 step: 0.01 in Q7
+    Fp::Fp32s fp = Fp::Fp32s((int32_t)9995, 7);
+    fp += Fp::Fp32s::from_raw(3, 7);
+    TEST_ASSERT_EQUAL_UINT8(7, fp.to_chars(buf, 2));
+    TEST_ASSERT_EQUAL_STRING("9995.02", buf);
+    fp = Fp::Fp32s(-2.5, 12);
+    TEST_ASSERT_EQUAL_UINT8(6, fp.to_chars(buf, 3));
+    TEST_ASSERT_EQUAL_STRING("-2.500", buf);
+}
+
+void test_parse(void)
+{
+    int32_t raw;
+    TEST_ASSERT_EQUAL_UINT8(4, Fp::detail::chars_to_fix32("12.5", 4, 8, raw));
+    TEST_ASSERT_EQUAL_INT32(3200, raw);
+    // half away from zero, like the text output
+    Fp::detail::chars_to_fix32("2.5", 3, 0, raw);
+    TEST_ASSERT_EQUAL_INT32(3, raw);
+    Fp::detail::chars_to_fix32("-0.5", 4, 0, raw);
+    TEST_ASSERT_EQUAL_INT32(-1, raw);
+    Fp::detail::chars_to_fix32("0.49999999999999999999", 22, 0, raw);
+    TEST_ASSERT_EQUAL_INT32(0, raw);
+    // 0.1 in Q32 = 429496729.6
+    Fp::detail::chars_to_fix32("0.1", 3, 32, raw);
+    TEST_ASSERT_EQUAL_INT32(429496730, raw);
+    // saturation
+    Fp::detail::chars_to_fix32("-2147483648", 11, 0, raw);
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, raw);
+    Fp::detail::chars_to_fix32("16777216", 8, 7, raw);
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, raw);
+    Fp::detail::chars_to_fix32("99999999999999999999999", 23, 0, raw);
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, raw);
+    // partial and invalid text
+    TEST_ASSERT_EQUAL_UINT8(2, Fp::detail::chars_to_fix32("5.Hz", 4, 0, raw));
+    TEST_ASSERT_EQUAL_INT32(5, raw);
+    TEST_ASSERT_EQUAL_UINT8(3, Fp::detail::chars_to_fix32("-.5", 3, 1, raw));
+    TEST_ASSERT_EQUAL_INT32(-1, raw);
+    TEST_ASSERT_EQUAL_UINT8(0, Fp::detail::chars_to_fix32("-.", 2, 8, raw));
+    TEST_ASSERT_EQUAL_UINT8(0, Fp::detail::chars_to_fix32("F100", 4, 8, raw));
+    TEST_ASSERT_EQUAL_UINT8(2, Fp::detail::chars_to_fix32("1234", 2, 8, raw));
+    TEST_ASSERT_EQUAL_INT32(12 << 8, raw);
+    int64_t raw64;
+    Fp::detail::chars_to_fix64("-0.000000000000000001", 21, 63, raw64);
+    TEST_ASSERT_TRUE(raw64 == -9);
+    Fp::detail::chars_to_fix64("1", 1, 63, raw64);
+    TEST_ASSERT_TRUE(raw64 == 0x7fffffffffffffffLL);
+}
+
+// text with enough digits reads back to the same raw value
+void test_parse_round_trip(void)
+{
+    char buf[48];
+    for (uint32_t n = 0; n < 300000; n++) {
+        int32_t raw = (int32_t)rnd() >> (rnd() & 31);
+        uint8_t q = rnd() % 33;
+        int32_t back;
+        uint8_t len = Fp::detail::fix32_to_chars(buf, raw, q, 12);
+        TEST_ASSERT_EQUAL_UINT8(len, Fp::detail::chars_to_fix32(buf, len, q, back));
+        TEST_ASSERT_EQUAL_INT32(raw, back);
+        int64_t raw64 = (int64_t)(((uint64_t)rnd() << 32) | rnd()) >> (rnd() & 63);
+        uint8_t p = rnd() % 51;
+        int64_t back64;
+        len = Fp::detail::fix64_to_chars(buf, raw64, p, 18);
+        TEST_ASSERT_EQUAL_UINT8(len, Fp::detail::chars_to_fix64(buf, len, p, back64));
+        TEST_ASSERT_TRUE(raw64 == back64);
+    }
+}
+
+void test_from_chars(void)
+{
+    Fp::Fp32s fp = Fp::Fp32s::from_chars("9995.02", 7, 7);
+    TEST_ASSERT_EQUAL_INT32(1279363, fp.rawVal);
+    TEST_ASSERT_EQUAL_UINT8(7, fp.q);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_div10);
+    RUN_TEST(test_edges);
+    RUN_TEST(test_carry);
+    RUN_TEST(test_random);
+    RUN_TEST(test_to_chars);
+    RUN_TEST(test_parse);
+    RUN_TEST(test_parse_round_trip);
+    RUN_TEST(test_from_chars);
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+/*
+    Host test of the reciprocal division (lib/MFixedPoint/FpDiv.hpp) and Fp32s /=
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <Fp32s.hpp>
+#include "../test_rnd.h"
+
+// old int64_t code of Fp32s::operator/=, quotient before the cast to int32_t
+// (the shifts of negative values written as products)
+static int64_t reference(int32_t a, uint8_t qa, int32_t b, uint8_t qb)
+{
+    if (qa == qb)
+        return ((int64_t)a * ((int64_t)1 << qa)) / (int64_t)b;
+    else if (qa > qb)
+        return (((int64_t)a >> (qa - qb)) * ((int64_t)1 << qb)) / (int64_t)b;
+    else
+        return ((int64_t)a * ((int64_t)1 << qa)) / ((int64_t)b >> (qb - qa));
+}
+
+// the division saturates outside int32_t
+static int64_t clamp_int32(int64_t x)
+{
+    return (x > 0x7fffffffL) ? 0x7fffffffL : (x < -0x7fffffffL - 1) ? -0x7fffffffL - 1 : x;
+}
+
+void test_clz32(void)
+{
+    for (uint8_t n = 0; n < 32; n++) {
+        TEST_ASSERT_EQUAL_UINT8(31 - n, Fp::detail::clz32((uint32_t)1 << n));
+        TEST_ASSERT_EQUAL_UINT8(31 - n, Fp::detail::clz32(((uint32_t)1 << n) | 1));
+    }
+}
+
+void test_fp32s_div_exact(void)
+{
+    for (uint32_t n = 0; n < 200000; n++) {
+        int32_t a = (int32_t)rnd() >> (rnd() & 31);
+        int32_t b = (int32_t)rnd() >> (rnd() & 31);
+        uint8_t qa = rnd() % 32;
+        uint8_t qb = rnd() % 32;
+        int32_t bs = (qa < qb) ? b >> (qb - qa) : b;
+        if (bs == 0)
+            continue;
+        int64_t expected = clamp_int32(reference(a, qa, b, qb));
+        Fp::Fp32s x = Fp::Fp32s::from_raw(a, qa);
+        x /= Fp::Fp32s::from_raw(b, qb);
+        TEST_ASSERT_EQUAL_INT32((int32_t)expected, x.rawVal);
+        TEST_ASSERT_EQUAL_UINT8(qa < qb ? qa : qb, x.q);
+    }
+}
+
+// error in ULP of the result, the result is never above the exact quotient
+// (saturated when it does not fit)
+template <Fp::DivMode mode>
+static void check_level(uint32_t shift, uint32_t max_ulp)
+{
+    for (uint32_t n = 0; n < 100000; n++) {
+        int32_t a = (int32_t)rnd() >> (rnd() & 31);
+        int32_t b = (int32_t)rnd() >> (rnd() & 31);
+        uint8_t q = rnd() % 33;
+        if (b == 0)
+            continue;
+        int64_t exact = (int64_t)(((__int128)a * ((__int128)1 << q)) / b);
+        int64_t sat = clamp_int32(exact);
+        int64_t result = Fp::detail::div32_shl(a, b, q, mode);
+        uint64_t abs_exact = (exact < 0) ? -exact : exact;
+        int64_t err = (exact < 0) ? result - sat : sat - result;
+        TEST_ASSERT_TRUE(err >= 0);
+        TEST_ASSERT_TRUE((uint64_t)err <= (abs_exact >> shift) + max_ulp);
+    }
+}
+
+void test_div_levels(void)
+{
+    check_level<Fp::DIV_NR1>(8, 1);
+    check_level<Fp::DIV_NR2>(16, 1);
+    check_level<Fp::DIV_NR3>(32, 5);
+    check_level<Fp::DIV_EXACT>(32, 0);
+}
+
+void test_div_saturate(void)
+{
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, Fp::detail::div32_shl(1, 0, 0, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, Fp::detail::div32_shl(-1, 0, 0, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, Fp::detail::div32_shl(1, 1, 32, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, Fp::detail::div32_shl(-0x7fffffffL - 1, 1, 31, Fp::DIV_EXACT));
+    // quotient in [2^31, 2^32): fits 32 bits, but not int32_t
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, Fp::detail::div32_shl(0x7fffffffL, 1, 1, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, Fp::detail::div32_shl(0x40000000L, 1, 1, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, Fp::detail::div32_shl(-0x40000000L, -1, 1, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, Fp::detail::div32_shl(-0x60000000L, 1, 1, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, Fp::detail::div32_shl(0x7fffffffL, -1, 1, Fp::DIV_EXACT));
+    // the limits themselves
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, Fp::detail::div32_shl(-0x40000000L, 1, 1, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, Fp::detail::div32_shl(0x7fffffffL, 1, 0, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(0x7ffffffeL, Fp::detail::div32_shl(0x3fffffffL, 1, 1, Fp::DIV_EXACT));
+    TEST_ASSERT_EQUAL_INT32(-0x7ffffffeL, Fp::detail::div32_shl(-0x3fffffffL, 1, 1, Fp::DIV_EXACT));
+}
+
+void test_div64_exact(void)
+{
+    for (uint32_t n = 0; n < 100000; n++) {
+        uint64_t r = ((uint64_t)rnd() << 32) | rnd();
+        int64_t a = (int64_t)r >> (32 + (rnd() & 31));
+        int64_t b = (int64_t)(((uint64_t)rnd() << 32) | rnd()) >> (rnd() & 63);
+        if (b == 0)
+            continue;
+        TEST_ASSERT_TRUE((a * ((int64_t)1 << 32)) / b == Fp::detail::div64_shl(a, b, 32, Fp::DIV_EXACT));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_clz32);
+    RUN_TEST(test_fp32s_div_exact);
+    RUN_TEST(test_div_levels);
+    RUN_TEST(test_div_saturate);
+    RUN_TEST(test_div64_exact);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/*
+    Host test of the fixed-point <-> float conversions (lib/MFixedPoint/FpFloat.hpp)
+    FP_FLOAT_BITS selects the AVR code, which must match the float arithmetic bit for bit.
+    Run: pio test -e native
+*/
+#define FP_FLOAT_BITS
+#include <unity.h>
+#include <string.h>
+#include <Fp32s.hpp>
+#include "../test_rnd.h"
+
+// conversion operators are still constant expressions
+static constexpr Fp::Fp32s fp_dbl = Fp::Fp32s(-2.5, 12);
+static_assert((float)fp_dbl == -2.5f, "(float)Fp32s(-2.5, 12)");
+static_assert(Fp::detail::float_to_fix32(-2.5f, 12) == -10240, "float_to_fix32(-2.5, 12)");
+
+static void check_same(int32_t raw, uint8_t q)
+{
+    volatile float expected = (float)raw / (float)((uint64_t)1 << q);
+    float result = Fp::detail::fix32_to_float_bits(raw, q);
+    float e = expected;
+    TEST_ASSERT_EQUAL_MEMORY(&e, &result, sizeof(float));
+}
+
+void test_edges(void)
+{
+    static const int32_t edge[] = {0, 1, -1, 2, 3, 0xffffff, 0x1000000, 0x1000001, 0x1000002, 0x1000003,
+                                   0x1ffffff, 0x7fffff80L, 0x7fffffbfL, 0x7fffffc0L, 0x7fffffffL, -0x7fffffffL - 1};
+    for (uint8_t q = 0; q <= 32; q++) {
+        for (uint8_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+            check_same(edge[i], q);
+            // negated as uint32_t, -INT32_MIN stays INT32_MIN
+            check_same((int32_t)(0 - (uint32_t)edge[i]), q);
+        }
+    }
+}
+
+void test_ties(void)
+{
+    // exactly half way between two floats, both directions of the even rounding
+    for (uint32_t n = 0; n < 100000; n++) {
+        uint8_t shift = 1 + rnd() % 7;
+        int32_t raw = (int32_t)(((rnd() | 0x800000UL) & 0xffffffUL) << shift) | ((int32_t)1 << (shift - 1));
+        check_same(raw, rnd() % 33);
+        check_same(-raw, rnd() % 33);
+    }
+}
+
+void test_random(void)
+{
+    for (uint32_t n = 0; n < 1000000; n++) {
+        check_same((int32_t)rnd() >> (rnd() & 31), rnd() % 33);
+    }
+}
+
+void test_operators(void)
+{
+    volatile int32_t raw = -1217380;
+    Fp::Fp32s fp = Fp::Fp32s::from_raw(raw, 14);
+    TEST_ASSERT_EQUAL_FLOAT(-74.302978515625f, (float)fp);
+    TEST_ASSERT_TRUE((double)fp == (double)(-1217380.0 / 16384.0));
+}
+
+// f * 2^q in double is exact for q <= 32, clamped so the cast to int64_t is defined
+static double scaled(float f, uint8_t q)
+{
+    double v = (double)f * (double)((uint64_t)1 << q);
+    return (v > 1e12) ? 1e12 : (v < -1e12) ? -1e12 : v;
+}
+
+static int64_t scaled_trunc(float f, uint8_t q)
+{
+    return (int64_t)scaled(f, q);
+}
+
+static int64_t scaled_nearest(float f, uint8_t q)
+{
+    double v = scaled(f, q);
+    return (int64_t)(v < 0 ? v - 0.5 : v + 0.5);
+}
+
+static int32_t saturate(int64_t v)
+{
+    return (v > 0x7fffffffL) ? 0x7fffffffL : (v < -0x7fffffffL - 1) ? -0x7fffffffL - 1 : (int32_t)v;
+}
+
+void test_float_to_fix_random(void)
+{
+    for (uint32_t n = 0; n < 1000000; n++) {
+        uint32_t bits = rnd();
+        // mostly exponents around the int32_t range
+        bits = (bits & 0x807fffffUL) | ((uint32_t)(100 + rnd() % 60) << 23);
+        float f = Fp::detail::float_from_bits(bits);
+        uint8_t q = rnd() % 33;
+        TEST_ASSERT_EQUAL_INT32(saturate(scaled_trunc(f, q)), Fp::detail::float_to_fix32_bits(f, q, Fp::ROUND_TRUNC));
+        TEST_ASSERT_EQUAL_INT32(saturate(scaled_nearest(f, q)), Fp::detail::float_to_fix32_bits(f, q, Fp::ROUND_NEAREST));
+        int64_t t = scaled_trunc(f, q);
+        if (t <= 0x7fffffffL && t >= -0x7fffffffL - 1) {
+            // same as the C++ cast where that is defined
+            volatile float vf = f;
+            TEST_ASSERT_EQUAL_INT32((int32_t)(vf * (float)((uint64_t)1 << q)), Fp::detail::float_to_fix32(vf, q));
+        }
+    }
+}
+
+void test_float_to_fix_special(void)
+{
+    using Fp::detail::float_to_fix32_bits;
+    TEST_ASSERT_EQUAL_INT32(0, float_to_fix32_bits(0.0f, 16, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(0, float_to_fix32_bits(-0.0f, 16, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(0, float_to_fix32_bits(1e-40f, 32, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(0, float_to_fix32_bits(Fp::detail::float_from_bits(0x7fc00000UL), 8, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, float_to_fix32_bits(Fp::detail::float_from_bits(0x7f800000UL), 8, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, float_to_fix32_bits(Fp::detail::float_from_bits(0xff800000UL), 8, Fp::ROUND_NEAREST));
+    // -2^31 fits, 2^31 does not
+    TEST_ASSERT_EQUAL_INT32(-0x7fffffffL - 1, float_to_fix32_bits(-1.0f, 31, Fp::ROUND_TRUNC));
+    TEST_ASSERT_EQUAL_INT32(0x7fffffffL, float_to_fix32_bits(1.0f, 31, Fp::ROUND_TRUNC));
+    // half way rounds away from zero
+    TEST_ASSERT_EQUAL_INT32(3, float_to_fix32_bits(2.5f, 0, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(-3, float_to_fix32_bits(-2.5f, 0, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(1, float_to_fix32_bits(0.5f, 0, Fp::ROUND_NEAREST));
+    TEST_ASSERT_EQUAL_INT32(0, float_to_fix32_bits(0.5f, 0, Fp::ROUND_TRUNC));
+}
+
+void test_from_float(void)
+{
+    Fp::Fp32s fp = Fp::Fp32s::from_float(0.01f, 7);
+    TEST_ASSERT_EQUAL_INT32(1, fp.rawVal);
+    TEST_ASSERT_EQUAL_UINT8(7, fp.q);
+    TEST_ASSERT_EQUAL_INT32(152265, Fp::Fp32s::from_float(9.2935f, 14).rawVal);
+    TEST_ASSERT_EQUAL_INT32(152264, Fp::Fp32s::from_float(9.2935f, 14, Fp::ROUND_TRUNC).rawVal);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_edges);
+    RUN_TEST(test_ties);
+    RUN_TEST(test_random);
+    RUN_TEST(test_operators);
+    RUN_TEST(test_float_to_fix_random);
+    RUN_TEST(test_float_to_fix_special);
+    RUN_TEST(test_from_float);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+/*
+    Host test of the fixed-point multiply kernel (lib/MFixedPoint/FpMul.hpp)
+    The AVR build runs mul32_shr_wide() with the asm product, here the portable
+    product is used, so the sign correction and the byte-wise shift are checked.
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <Fp32s.hpp>
+#include "../test_rnd.h"
+
+static int32_t reference(int32_t a, int32_t b, uint8_t q)
+{
+    return (int32_t)(((int64_t)a * b) >> q);
+}
+
+void test_umul32_wide(void)
+{
+    static const uint32_t edge[] = {0, 1, 0xff, 0x100, 0xffff, 0x7fffffffUL, 0x80000000UL, 0xffffffffUL};
+    for (uint8_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+        for (uint8_t j = 0; j < sizeof(edge) / sizeof(edge[0]); j++) {
+            uint32_t lo, hi;
+            Fp::detail::umul32_wide(edge[i], edge[j], lo, hi);
+            uint64_t p = (uint64_t)edge[i] * edge[j];
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)p, lo);
+            TEST_ASSERT_EQUAL_UINT32((uint32_t)(p >> 32), hi);
+        }
+    }
+}
+
+void test_mul32_shr_wide_edges(void)
+{
+    static const int32_t edge[] = {0, 1, -1, 2, -2, 255, -256, 65535, -65536,
+                                   0x7fffffffL, -0x7fffffffL - 1, 0x12345678L, -0x12345678L};
+    for (uint8_t q = 0; q <= 32; q++) {
+        for (uint8_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+            for (uint8_t j = 0; j < sizeof(edge) / sizeof(edge[0]); j++) {
+                TEST_ASSERT_EQUAL_INT32(reference(edge[i], edge[j], q), Fp::detail::mul32_shr_wide(edge[i], edge[j], q));
+            }
+        }
+    }
+}
+
+void test_mul32_shr_wide_random(void)
+{
+    for (uint32_t n = 0; n < 200000; n++) {
+        int32_t a = (int32_t)rnd();
+        int32_t b = (int32_t)rnd();
+        // also small operands, as in the real fixed-point use
+        if (n & 1) {
+            a >>= rnd() & 31;
+            b >>= rnd() & 31;
+        }
+        uint8_t q = rnd() % 33;
+        TEST_ASSERT_EQUAL_INT32(reference(a, b, q), Fp::detail::mul32_shr_wide(a, b, q));
+    }
+}
+
+// constant operands are folded, so the kernel still works in constant expressions
+static_assert(Fp::detail::mul32_shr(-3 * 16384, 5 * 16384, 14) == -15 * 16384, "mul32_shr constexpr");
+
+void test_fp32s_mul(void)
+{
+    for (uint32_t n = 0; n < 20000; n++) {
+        int32_t a = (int32_t)rnd() >> (rnd() & 31);
+        int32_t b = (int32_t)rnd() >> (rnd() & 31);
+        uint8_t qa = rnd() % 32;
+        uint8_t qb = rnd() % 32;
+        Fp::Fp32s x = Fp::Fp32s::from_raw(a, qa);
+        x *= Fp::Fp32s::from_raw(b, qb);
+        // old int64_t code of Fp32s::operator*=
+        int32_t expected;
+        if (qa == qb)
+            expected = (int32_t)(((int64_t)a * (int64_t)b) >> qa);
+        else if (qa > qb)
+            expected = (int32_t)((((int64_t)a >> (qa - qb)) * (int64_t)b) >> qb);
+        else
+            expected = (int32_t)(((int64_t)a * ((int64_t)b >> (qb - qa))) >> qa);
+        TEST_ASSERT_EQUAL_INT32(expected, x.rawVal);
+        TEST_ASSERT_EQUAL_UINT8(qa < qb ? qa : qb, x.q);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_umul32_wide);
+    RUN_TEST(test_mul32_shr_wide_edges);
+    RUN_TEST(test_mul32_shr_wide_random);
+    RUN_TEST(test_fp32s_mul);
+    return UNITY_END();
+}
@@ -0,0 +1,71 @@
+/*
+    Host test of Dds::FrequencyConverter against the 64-bit multiplication reference
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <FrequencyConverter.hpp>
+
+typedef unsigned __int128 u128;
+
+static const uint32_t clock = 125000000UL;
+
+// exact floor(tword * clock * 100 / 2^32)
+static uint64_t ref_hz100(uint32_t tword, uint32_t clk)
+{
+    return (uint64_t)(((u128)tword * clk * 100) >> 32);
+}
+
+// the tword ranges swept by test_math3 give the same values as its int100 path
+void test_convert_math3_ranges(void)
+{
+    static const uint32_t tword_test[] = {0, 34300, 343600, 1717900, 3435900, 5188300, 34359700, 51539600, 343597300, 687194700};
+    Dds::FrequencyConverter conv(clock);
+    for (size_t t = 0; t < sizeof(tword_test)/sizeof(tword_test[0]); t++) {
+        for (uint32_t tword = tword_test[t]; tword < tword_test[t] + 100000; tword++) {
+            uint32_t freq100i = ((uint64_t)tword * (uint64_t)clock * 100) >> 32;
+            TEST_ASSERT_EQUAL_UINT32(freq100i, conv.convert(tword).hz100());
+        }
+    }
+}
+
+void test_convert_full_range(void)
+{
+    static const uint32_t clocks[] = {125000000UL, 180000000UL, 25000000UL, 4294967295UL};
+    for (size_t c = 0; c < sizeof(clocks)/sizeof(clocks[0]); c++) {
+        Dds::FrequencyConverter conv(clocks[c]);
+        for (uint64_t tword = 0; tword <= UINT32_MAX; tword += 4093) {
+            uint64_t ref = ref_hz100((uint32_t)tword, clocks[c]);
+            Dds::Frequency f = conv.convert((uint32_t)tword);
+            TEST_ASSERT_EQUAL_UINT64(ref / 100, f.hz);
+            TEST_ASSERT_EQUAL_UINT32(ref % 100, f.centi);
+        }
+        Dds::Frequency f = conv.convert(UINT32_MAX);
+        TEST_ASSERT_EQUAL_UINT64(ref_hz100(UINT32_MAX, clocks[c]) / 100, f.hz);
+    }
+}
+
+void test_centi_to_chars(void)
+{
+    char buf[3];
+    Dds::Frequency f;
+    f.hz = 12;
+    f.centi = 5;
+    f.centi_to_chars(buf);
+    TEST_ASSERT_EQUAL_STRING("05", buf);
+    f.centi = 99;
+    f.centi_to_chars(buf);
+    TEST_ASSERT_EQUAL_STRING("99", buf);
+    f.centi = 0;
+    f.centi_to_chars(buf);
+    TEST_ASSERT_EQUAL_STRING("00", buf);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_convert_math3_ranges);
+    RUN_TEST(test_convert_full_range);
+    RUN_TEST(test_centi_to_chars);
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,257 @@
+/*
+    Host test of the Logging library (lib/logging): the exact bytes of the
+    text lines, dumps and binary records, captured by LOG_SINK_RAM. The shim
+    clock stands still, shim_set_micros() moves it.
+    Run: pio test -e native_logging (-e native_logging_tokenized for the
+    LOG_TOKENIZED records)
+*/
+#include <unity.h>
+#include <string.h>
+#include <Logging.h>
+
+static void check_bytes(const uint8_t *exp, uint16_t n)
+{
+    TEST_ASSERT_EQUAL_UINT16(0, Log.Sink().lost);
+    TEST_ASSERT_EQUAL_UINT16(n, Log.Sink().len);
+    TEST_ASSERT_EQUAL_MEMORY(exp, Log.Sink().data, n);
+}
+
+static const uint8_t dump_data[] = {0x3B, 0x9A};
+
+#if !LOG_TOKENIZED
+static void check_text(const char *exp)
+{
+    check_bytes((const uint8_t *)exp, (uint16_t)strlen(exp));
+}
+
+// formats of the typed front end called directly, so the record holds a known address
+struct FmtRec {
+    static constexpr const char *str() { return "q=%q y=%y L=%L"; }
+};
+static const char text_rec[] PROGMEM = "q=%q y=%y L=%L";
+
+void test_text_typed_varargs(void)
+{
+    shim_set_micros(0);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_NONE, true);
+    LOG_INFO("f=%u Hz %d %x %X %s %T %t 100%%", (uint32_t)125000000UL, -5, 255, 10, "ab", true, false);
+    Log.Info(F("f=%u Hz %d %x %X %s %T %t 100%%"), (uint32_t)125000000UL, -5, 255, 10, "ab", 1, 0);
+    check_text("f=125000000 Hz -5 FF 0xA ab true F 100%\r\n"
+               "f=125000000 Hz -5 FF 0xA ab true F 100%\r\n");
+
+    Log.Sink().clear();
+    LOG_ERROR("e %c %y %B", 'A', (uint8_t)5, 5);
+    Log.Error("e %c %y %B", 'A', 5, 5);
+    check_text("ERROR: e 65 00000101 0b101\r\n"
+               "ERROR: e 65 00000101 0b101\r\n");
+
+    Log.Sink().clear();
+    LOG_DEBUG("%L %U %H", (int64_t)-1234567890123LL, (uint64_t)18446744073709551615ULL, (uint64_t)0x123456789ABULL);
+    Log.Debug("%L %U %H", (int64_t)-1234567890123LL, (uint64_t)18446744073709551615ULL, (uint64_t)0x123456789ABULL);
+    check_text("-1234567890123 18446744073709551615 123456789AB\r\n"
+               "-1234567890123 18446744073709551615 123456789AB\r\n");
+
+    // fixed point: typed only, default decimals of q and a precision
+    Log.Sink().clear();
+    LOG_VERBOSE("%q %2q %3Q", log_fix32(57344, 14), log_fix32(57344, 14), log_fix64(-5368709120LL, 32));
+    check_text("3.5000 3.50 -1.250\r\n");
+
+    // below the level of Init: nothing
+    Log.Init(LOG_LEVEL_INFOS, 38400L, LOG_TS_NONE, false);
+    LOG_DEBUG("x %d", 1);
+    Log.Verbose("x %d", 1);
+    LOG_INFO("i");
+    check_text("i");
+}
+
+void test_text_long_line(void)
+{
+    static const char s60[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWX";
+    static const char s20[] = "ABCDEFGHIJKLMNOPQRST";
+    static const char line[] =
+        "0000003009 ms: 0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWX|"
+        "ABCDEFGHIJKLMNOPQRST|3.5000\r\n";
+    TEST_ASSERT_TRUE(sizeof(line) - 1 > 2 * LOG_LINE_SIZE - LOG_FIX_CHARS);
+
+    shim_set_micros(3009000UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MILLIS, true);
+    LOG_INFO("%s|%s|%q", s60, s20, log_fix32(57344, 14));
+    check_text(line);
+
+    Log.Sink().clear();
+    Log.Info("%s|%s|%s", s60, s20, "3.5000");
+    check_text(line);
+}
+
+void test_text_ts_modes(void)
+{
+    shim_set_micros(3009000UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MILLIS, true);
+    LOG_INFO("a");
+    LOG_ERROR("b");
+    check_text("0000003009 ms: a\r\n"
+               "ERROR: 0000003009 ms: b\r\n");
+
+    shim_set_micros(4294967295UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MICROS, false);
+    Log.Info("c");
+    check_text("4294967295 us: c");
+
+    // delta: from Init, then from the previous message
+    shim_set_micros(1000000UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MILLIS | LOG_TS_DELTA, true);
+    shim_set_micros(1412000UL);
+    LOG_INFO("d");
+    shim_set_micros(1500000UL);
+    Log.Info("e");
+    check_text("+0000000412 ms: d\r\n"
+               "+0000000088 ms: e\r\n");
+
+    shim_set_micros(100UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MICROS | LOG_TS_DELTA, true);
+    shim_set_micros(112UL);
+    LOG_INFO("f");
+    check_text("+0000000012 us: f\r\n");
+}
+
+void test_text_dump(void)
+{
+    shim_set_micros(0);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_NONE, true);
+    Log.Dump("b", dump_data, 2, LOG_DUMP_BIN);
+    Log.Dump("h", dump_data, 2, LOG_DUMP_HEX);
+    Log.Dump("y", dump_data, 2, LOG_DUMP_BYTES);
+    Log.Dump("m", dump_data, 2, LOG_DUMP_HEX | LOG_DUMP_MSB);
+    Log.Dump("n", dump_data, 2, LOG_DUMP_BIN | LOG_DUMP_MSB);
+    check_text("b: 00111011-10011010\r\n"
+               "h: 3B9A\r\n"
+               "y: 3B 9A\r\n"
+               "m: 9A3B\r\n"
+               "n: 10011010-00111011\r\n");
+
+    // raw: a dump record even in the text mode, straight to the sink
+    Log.Sink().clear();
+    Log.Dump("v", dump_data, 2, LOG_DUMP_RAW | LOG_DUMP_MSB);
+    static const uint8_t raw[] = {LOG_REC_SYNC, 6, LOG_LEVEL_INFOS | LOG_REC_DUMP | LOG_REC_LN,
+        LOG_DUMP_RAW, 'v', 0, 0x9A, 0x3B};
+    check_bytes(raw, sizeof(raw));
+
+    // an info line: not at the errors level
+    Log.Init(LOG_LEVEL_ERRORS, 38400L, LOG_TS_NONE, true);
+    Log.Dump("b", dump_data, 2, LOG_DUMP_BIN);
+    check_text("");
+}
+
+void test_binary_records(void)
+{
+    shim_set_micros(0);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_NONE, false, true);
+    // the session record waits in the buffer
+    check_text("");
+
+    const __FlashStringHelper *f = F("x=%d y=%u");
+    uint16_t a = (uint16_t)(uintptr_t)f;
+    Log.Info(f, -2, (uint32_t)7);
+    Log.Error("a%d", 1);
+    Log.Flush();
+    const uint8_t rec[] = {
+        LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, LOG_TS_NONE,
+        LOG_REC_SYNC, 11, LOG_LEVEL_INFOS, (uint8_t)a, (uint8_t)(a >> 8),
+            0xFE, 0xFF, 0xFF, 0xFF, 7, 0, 0, 0,
+        LOG_REC_SYNC, 9, LOG_LEVEL_ERRORS | LOG_REC_INLINE, 'a', '%', 'd', 0, 1, 0, 0, 0};
+    check_bytes(rec, sizeof(rec));
+
+    // time stamp, CR LF flag, typed arguments: fix32 as 4 bytes and q
+    shim_set_micros(3009000UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MILLIS, true, true);
+    Log.write<FmtRec>(LOG_LEVEL_DEBUG, text_rec, log_fix32(-24576, 14), (uint8_t)0x5A, (int64_t)-2);
+    Log.Dump("v", dump_data, 2, LOG_DUMP_HEX);
+    Log.Drain();
+    uint16_t t = (uint16_t)(uintptr_t)text_rec;
+    const uint8_t rec_ts[] = {
+        LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, LOG_TS_MILLIS,
+        LOG_REC_SYNC, 21, LOG_LEVEL_DEBUG | LOG_REC_TS | LOG_REC_LN, 0xC1, 0x0B, 0, 0,
+            (uint8_t)t, (uint8_t)(t >> 8), 0x00, 0xA0, 0xFF, 0xFF, 14, 0x5A,
+            0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        LOG_REC_SYNC, 10, LOG_LEVEL_INFOS | LOG_REC_DUMP | LOG_REC_TS | LOG_REC_LN, 0xC1, 0x0B, 0, 0,
+            LOG_DUMP_HEX, 'v', 0, 0x3B, 0x9A};
+    check_bytes(rec_ts, sizeof(rec_ts));
+}
+
+// SetLevel and SetMode instead of a new Init: the buffered records go out first
+void test_binary_set_mode(void)
+{
+    shim_set_micros(0);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_NONE, false, true);
+    Log.Info("a");
+    Log.SetLevel(LOG_LEVEL_ERRORS);
+    Log.Info("b");
+    Log.SetLevel(LOG_LEVEL_VERBOSE);
+    Log.SetMode(LOG_TS_NONE, true, false);
+    LOG_INFO("c");
+    Log.SetMode(LOG_TS_NONE, false, true);
+    Log.Info("d");
+    Log.Flush();
+    const uint8_t rec[] = {
+        LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, LOG_TS_NONE,
+        LOG_REC_SYNC, 3, LOG_LEVEL_INFOS | LOG_REC_INLINE, 'a', 0,
+        'c', '\r', '\n',
+        LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, LOG_TS_NONE,
+        LOG_REC_SYNC, 3, LOG_LEVEL_INFOS | LOG_REC_INLINE, 'd', 0};
+    check_bytes(rec, sizeof(rec));
+}
+
+#else // LOG_TOKENIZED
+
+void test_token_records(void)
+{
+    shim_set_micros(300UL);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_MICROS, false);
+    // typed and varargs: the same record, time stamp and arguments as varints
+    LOG_INFO("t=%d u=%u", -3, (uint32_t)300);
+    Log.Info(LOG_FMT("t=%d u=%u"), -3, (uint32_t)300);
+    Log.Flush();
+    const uint8_t rec[] = {
+        LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, LOG_TS_MICROS,
+        LOG_REC_SYNC, 8, LOG_LEVEL_INFOS | LOG_REC_TOKEN | LOG_REC_TS, 0xAC, 0x02, 0x7D, 0x71, 0x05, 0xAC, 0x02,
+        LOG_REC_SYNC, 8, LOG_LEVEL_INFOS | LOG_REC_TOKEN | LOG_REC_TS, 0xAC, 0x02, 0x7D, 0x71, 0x05, 0xAC, 0x02};
+    check_bytes(rec, sizeof(rec));
+}
+
+void test_token_kinds(void)
+{
+    shim_set_micros(0);
+    Log.Init(LOG_LEVEL_VERBOSE, 38400L, LOG_TS_NONE, true);
+    // fix32: zigzag raw and q, fix64: the 64-bit varint and q
+    LOG_DEBUG("q=%q Q=%2Q", log_fix32(-24576, 14), log_fix64((int64_t)5 << 40, 40));
+    LOG_ERROR("L=%L U=%U s=%s y=%y", (int64_t)-1, (uint64_t)300, "ok", (uint8_t)0x5A);
+    Log.Dump("v", dump_data, 2, LOG_DUMP_BYTES | LOG_DUMP_MSB);
+    Log.Flush();
+    const uint8_t rec[] = {
+        LOG_REC_SYNC, 2, LOG_LEVEL_NOOUTPUT, LOG_TS_NONE,
+        LOG_REC_SYNC, 15, LOG_LEVEL_DEBUG | LOG_REC_TOKEN | LOG_REC_LN, 0x67, 0x50,
+            0xFF, 0xFF, 0x02, 14, 0x80, 0x80, 0x80, 0x80, 0x80, 0xC0, 0x02, 40,
+        LOG_REC_SYNC, 10, LOG_LEVEL_ERRORS | LOG_REC_TOKEN | LOG_REC_LN, 0xCB, 0xBD,
+            0x01, 0xAC, 0x02, 'o', 'k', 0, 0x5A,
+        LOG_REC_SYNC, 6, LOG_LEVEL_INFOS | LOG_REC_DUMP | LOG_REC_LN, LOG_DUMP_BYTES, 'v', 0, 0x9A, 0x3B};
+    check_bytes(rec, sizeof(rec));
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+#if !LOG_TOKENIZED
+    RUN_TEST(test_text_typed_varargs);
+    RUN_TEST(test_text_long_line);
+    RUN_TEST(test_text_ts_modes);
+    RUN_TEST(test_text_dump);
+    RUN_TEST(test_binary_records);
+    RUN_TEST(test_binary_set_mode);
+#else
+    RUN_TEST(test_token_records);
+    RUN_TEST(test_token_kinds);
+#endif
+    UNITY_END();
+    return 0;
+}
@@ -0,0 +1,20 @@
+/*
+    Pseudo-random operands for the host tests (test/test_fp_*)
+    xorshift32 with a fixed seed, every run checks the same operands.
+    Each test is its own program, so each one starts from the seed.
+*/
+#ifndef TEST_RND_H
+#define TEST_RND_H
+
+#include <stdint.h>
+
+static uint32_t rnd_state = 2463534242UL;
+static uint32_t rnd(void)
+{
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+#endif // TEST_RND_H
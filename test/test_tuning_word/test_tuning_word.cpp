@@ -0,0 +1,181 @@
+/*
+    Host test of Dds::TuningWordConverter against the 64-bit division reference
+    Run: pio test -e native
+*/
+#include <unity.h>
+#include <TuningWordConverter.hpp>
+
+typedef unsigned __int128 u128;
+
+static const uint32_t clocks[] = {125000000UL, 180000000UL, 25000000UL, 30000000UL, 100000002UL, 4294967294UL,
+                                  100000001UL, 4294967295UL, 3UL, 2UL};
+#define CLOCK_COUNT (sizeof(clocks)/sizeof(clocks[0]))
+
+static uint32_t ref_hz(uint32_t f, uint32_t clock)
+{
+    return (uint32_t)(((uint64_t)f << 32) / clock);
+}
+
+static uint32_t ref_hz100(uint32_t f100, uint32_t clock)
+{
+    return (uint32_t)((((uint64_t)f100 << 32) / clock) / 100L);
+}
+
+// Proof of exactness over the whole 32-bit input range: m is the rounded up
+// reciprocal and the shift satisfies 2^shift * gcd(2^32, d) >= (2^32 - 1) * d.
+static void check_reciprocal(uint64_t d)
+{
+    Dds::Reciprocal rcp(d);
+    u128 m = ((u128)rcp.m_hi << 64) | rcp.m;
+    u128 pow = (u128)1 << (rcp.shift + 32);
+    TEST_ASSERT_TRUE(m * d >= pow);
+    TEST_ASSERT_TRUE((m - 1) * d < pow);
+
+    u128 g = 1;
+    while (g < ((u128)1 << 32) && (d % (uint64_t)(g * 2)) == 0) g *= 2;
+    TEST_ASSERT_TRUE(((u128)1 << rcp.shift) * g >= (u128)UINT32_MAX * d);
+}
+
+void test_reciprocal_bounds(void)
+{
+    for (size_t c = 0; c < CLOCK_COUNT; c++) {
+        check_reciprocal(clocks[c]);
+        check_reciprocal((uint64_t)clocks[c] * 100);
+    }
+}
+
+// The multiply and shift must give exactly (n * m) >> shift, also with bit 64 of m
+void test_reciprocal_product(void)
+{
+    static const uint64_t d[] = {(uint64_t)125000000UL * 100, 100000001UL, 4294967295UL, 2};
+    for (size_t k = 0; k < sizeof(d)/sizeof(d[0]); k++) {
+        Dds::Reciprocal rcp(d[k]);
+        u128 m = ((u128)rcp.m_hi << 64) | rcp.m;
+        uint32_t n = 1;
+        for (uint32_t i = 0; i < 1000000; i++) {
+            n = n * 1664525UL + 1013904223UL;
+            TEST_ASSERT_EQUAL_UINT64((uint64_t)((n * m) >> rcp.shift), rcp.apply(n));
+        }
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)((UINT32_MAX * m) >> rcp.shift), rcp.apply(UINT32_MAX));
+    }
+}
+
+// Odd clocks: the 65-bit multiplier, the worst remainders of from_hz (g = 1)
+void test_from_hz_odd(void)
+{
+    static const uint32_t odd[] = {100000001UL, 4294967295UL, 3UL, 124999999UL};
+    for (size_t c = 0; c < sizeof(odd)/sizeof(odd[0]); c++) {
+        const uint32_t clock = odd[c];
+        Dds::TuningWordConverter conv(clock);
+        TEST_ASSERT_TRUE(Dds::Reciprocal(clock).m_hi);
+        for (uint32_t f = 0; f < 1000000; f++) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz(f, clock), conv.from_hz(f));
+        }
+        for (uint32_t f = UINT32_MAX - 1000000; f != 0; f++) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz(f, clock), conv.from_hz(f));
+        }
+        // n * 2^32 mod clock = clock - 1: n = -(2^32)^-1 mod clock
+        uint64_t a = ((uint64_t)1 << 32) % clock;
+        int64_t t = 0, newt = 1, r = clock, newr = (int64_t)a;
+        while (newr != 0) {
+            int64_t k = r / newr;
+            int64_t tmp = t - k * newt; t = newt; newt = tmp;
+            tmp = r - k * newr; r = newr; newr = tmp;
+        }
+        if (t < 0) t += clock;
+        for (uint64_t n = (clock - (uint64_t)t) % clock; n <= UINT32_MAX; n += clock) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz((uint32_t)n, clock), conv.from_hz((uint32_t)n));
+            if (clock < 1000 && n > 100000000UL) break;
+        }
+    }
+}
+
+// Every frequency below the 125 MHz clock
+void test_from_hz_exhaustive(void)
+{
+    const uint32_t clock = 125000000UL;
+    Dds::TuningWordConverter conv(clock);
+    for (uint32_t f = 0; f < clock; f++) {
+        if (conv.from_hz(f) != ref_hz(f, clock)) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz(f, clock), conv.from_hz(f));
+        }
+    }
+}
+
+// Inputs whose remainder n * 2^32 mod d is the largest possible (d - j * g),
+// these are the first to break if the reciprocal is not precise enough.
+static void check_worst_remainders(const Dds::TuningWordConverter &conv, uint32_t clock)
+{
+    uint64_t d = (uint64_t)clock * 100;
+    uint64_t g = 1;
+    while (g < ((uint64_t)1 << 32) && (d % (g * 2)) == 0) g *= 2;
+    int64_t odd = (int64_t)(d / g);
+    int64_t a = (int64_t)((((uint64_t)1 << 32) / g) % (uint64_t)odd);
+    // inverse of a modulo odd
+    int64_t t = 0, newt = 1, r = odd, newr = a;
+    while (newr != 0) {
+        int64_t k = r / newr;
+        int64_t tmp = t - k * newt; t = newt; newt = tmp;
+        tmp = r - k * newr; r = newr; newr = tmp;
+    }
+    if (t < 0) t += odd;
+    for (int64_t j = 1; j <= 64; j++) {
+        uint64_t n = (uint64_t)(((u128)(odd - j % odd) * (uint64_t)t) % (uint64_t)odd);
+        for (; n <= UINT32_MAX; n += (uint64_t)odd) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz100((uint32_t)n, clock), conv.from_hz100((uint32_t)n));
+        }
+    }
+}
+
+void test_from_hz100(void)
+{
+    for (size_t c = 0; c < CLOCK_COUNT; c++) {
+        uint32_t clock = clocks[c];
+        Dds::TuningWordConverter conv(clock);
+        // ranges swept by test_math2
+        static const uint32_t start[] = {0, 100000, 999500, 5000000, 10000000, 15099500, 100000000, 149999500, 1000000000, 1999999500};
+        for (size_t s = 0; s < sizeof(start)/sizeof(start[0]); s++) {
+            for (uint32_t f = start[s]; f < start[s] + 100000; f++) {
+                TEST_ASSERT_EQUAL_UINT32(ref_hz100(f, clock), conv.from_hz100(f));
+            }
+        }
+        for (uint32_t f = UINT32_MAX - 100000; f != 0; f++) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz100(f, clock), conv.from_hz100(f));
+        }
+        for (uint64_t f = 0; f <= UINT32_MAX; f += 65521) {
+            TEST_ASSERT_EQUAL_UINT32(ref_hz100((uint32_t)f, clock), conv.from_hz100((uint32_t)f));
+        }
+        check_worst_remainders(conv, clock);
+    }
+}
+
+void test_from_fp(void)
+{
+    const uint32_t clock = 125000000UL;
+    Dds::TuningWordConverter conv(clock);
+    for (uint8_t q = 0; q <= 16; q++) {
+        for (int32_t raw = 0; raw < 2000000; raw += 7) {
+            Fp::Fp32s f;
+            f.rawVal = raw;
+            f.q = q;
+            uint32_t ref = (uint32_t)((((uint64_t)raw << 32) / clock) >> q);
+            TEST_ASSERT_EQUAL_UINT32(ref, conv.from_fp(f));
+        }
+    }
+    // 0.01 Hz steps as in test_math2
+    Fp::Fp32s freq = Fp::Fp32s((int32_t)1000000, 7);
+    TEST_ASSERT_EQUAL_UINT32(ref_hz(1000000, clock), conv.from_fp(freq));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_reciprocal_bounds);
+    RUN_TEST(test_reciprocal_product);
+    RUN_TEST(test_from_hz_odd);
+    RUN_TEST(test_from_hz_exhaustive);
+    RUN_TEST(test_from_hz100);
+    RUN_TEST(test_from_fp);
+    UNITY_END();
+    return 0;
+}
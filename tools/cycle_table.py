@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""Table of the CPU cycles measured on the board by bench_cycles() in
+src/math.cpp, from a text log (a capture, the host build or the output of
+tools/log_decode.py):
+
+    tools/cycle_table.py capture.txt
+    tools/cycle_table.py --markdown capture.txt > cycles.md
+
+The sketch writes "CB CLOCK: ticks/s <tab> overhead <tab> samples" and then
+one "CB: name <tab> min <tab> median <tab> max" line per row, in ticks with
+the call overhead already subtracted (cycles on the board, ns on the host).
+A row logged again (next loop pass) replaces the earlier one. Exit status
+is 1 if the log has no rows.
+"""
+
+import argparse
+import re
+import sys
+
+CLOCK = re.compile(r'CB CLOCK: (\d+)\t(\d+)\t(\d+)')
+ROW = re.compile(r'CB: (.+?)\t(\d+)\t(\d+)\t(\d+)\s*$')
+
+
+def read_rows(path):
+    clock = None
+    rows = {}
+    with open(path, 'rb') as f:
+        text = f.read().decode('latin-1')
+    for line in text.replace('\r\n', '\n').split('\n'):
+        m = CLOCK.search(line)
+        if m:
+            clock = tuple(int(v) for v in m.groups())
+            continue
+        m = ROW.search(line)
+        if m:
+            rows[m.group(1)] = tuple(int(v) for v in m.groups()[1:])
+    return clock, rows
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Table of the bench_cycles() results.')
+    parser.add_argument('--markdown', action='store_true', help='markdown table')
+    parser.add_argument('--csv', action='store_true', help='comma separated values')
+    parser.add_argument('log', help='text log with the CB: lines')
+    opt = parser.parse_args(argv[1:])
+    clock, rows = read_rows(opt.log)
+    if not rows:
+        print('%s: no CB: lines' % opt.log, file=sys.stderr)
+        return 1
+    hz = clock[0] if clock else 16000000
+    unit = 'cycles' if hz < 1000000000 else 'ns'
+    head = ['op', 'min', 'median', 'max', 'median us']
+    table = [[name, str(v[0]), str(v[1]), str(v[2]), '%.2f' % (v[1] * 1e6 / hz)]
+             for name, v in rows.items()]
+    if opt.csv:
+        print(','.join(head))
+        for r in table:
+            print(','.join(r))
+        return 0
+    if clock:
+        print('%s at %d Hz, overhead %d subtracted, %d samples per row' % (unit, hz, clock[1], clock[2]))
+    else:
+        print('%s (no CB CLOCK: line, %d Hz assumed)' % (unit, hz))
+    print()
+    if opt.markdown:
+        print('| ' + ' | '.join(head) + ' |')
+        print('|' + '|'.join(['---'] + ['---:'] * (len(head) - 1)) + '|')
+        for r in table:
+            print('| ' + ' | '.join(r) + ' |')
+        return 0
+    width = [max(len(r[i]) for r in table + [head]) for i in range(len(head))]
+    for r in [head] + table:
+        print('  '.join([r[0].ljust(width[0])] + [c.rjust(w) for c, w in zip(r[1:], width[1:])]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,310 @@
+/*
+    Exhaustive host check of the DDS conversions of the sketch against the exact values
+    Build: g++ -O2 -std=gnu++11 -pthread -Ilib/dds -Ilib/MFixedPoint tools/dds_verify.cpp -o dds_verify
+    Run:   ./dds_verify [--clock HZ] [--threads N] [--stride N]
+
+    tword -> freq (test_math3), every 32-bit tuning word, freq = tword * clock / 2^32:
+        float           (float)tword * (float)clock / UINT32_MAX
+        float dtostrf   the same float as dtostrf(freqf, 0, 2) prints it (avr-libc text:
+                        8 significant digits at most, rounded half up)
+        int100          FrequencyConverter::convert(), hz * 100 + centi
+    freq -> tword (test_math2), every frequency in 1/100 Hz below 2^32 (and below clock),
+    tword = freq * 2^32 / clock:
+        float           freqf * UINT32_MAX / clock with freqf = freq100 / 100.0F
+        int100          TuningWordConverter::from_hz100()
+        Fp32s q7        TuningWordConverter::from_fp(Fp32s(hz, centi, 100, 7))
+
+    The references are integers scaled from the exact rational values (128-bit, no
+    float). Per method: max and mean absolute error, mean signed error (bias), the
+    input of the max error and the number of results that are not floor (the rounding
+    the integer methods promise) or not round half up of the exact value. The float
+    results are IEEE single precision like the avr-libc ones (no -ffast-math).
+
+    The inputs are split in chunks among the threads, each thread owns a range and a
+    thread that runs out takes the upper half of the largest range left (work stealing).
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <TuningWordConverter.hpp>
+#include <FrequencyConverter.hpp>
+
+typedef unsigned __int128 u128;
+typedef __int128 s128;
+
+static const uint64_t CHUNK = 1 << 16;
+
+// Errors of one method, in units of the direction's scale
+struct Stat {
+    u128 max_err;
+    u128 sum_err;
+    s128 sum_signed;
+    uint64_t worst;
+    uint64_t off_floor;
+    uint64_t off_nearest;
+    uint64_t count;
+
+    Stat() : max_err(0), sum_err(0), sum_signed(0), worst(0), off_floor(0), off_nearest(0), count(0)
+    {
+    }
+
+    // err - result - exact, floor/nearest_ok - the result is the rounded exact value
+    // (-1 to skip), the worst input is the lowest one of the max error
+    void add(uint64_t in, s128 err, int8_t floor_ok, int8_t nearest_ok)
+    {
+        u128 a = (err < 0) ? (u128)(-err) : (u128)err;
+        if (a > max_err || (a == max_err && in < worst) || count == 0) {
+            max_err = a;
+            worst = in;
+        }
+        sum_err += a;
+        sum_signed += err;
+        off_floor += (floor_ok == 0);
+        off_nearest += (nearest_ok == 0);
+        count++;
+    }
+
+    void merge(const Stat &s)
+    {
+        if (s.count != 0 && (s.max_err > max_err || (s.max_err == max_err && s.worst < worst) || count == 0)) {
+            max_err = s.max_err;
+            worst = s.worst;
+        }
+        sum_err += s.sum_err;
+        sum_signed += s.sum_signed;
+        off_floor += s.off_floor;
+        off_nearest += s.off_nearest;
+        count += s.count;
+    }
+};
+
+enum { T_FLOAT, T_DTOSTRF, T_INT100, F_FLOAT, F_INT100, F_FP, METHODS };
+
+static const char *method_name[METHODS] = {
+    "float", "float dtostrf", "int100", "float", "int100", "Fp32s q7"
+};
+
+static uint32_t clock_hz = 125000000UL;
+static uint64_t stride = 1;
+static uint64_t tword_count;  // inputs of tword -> freq
+static uint64_t freq_count;   // inputs of freq -> tword
+
+// value of x * 2^64 (x = 0 or x >= 2^-41, so it is an integer)
+static u128 float_scaled64(float x)
+{
+    return (u128)ldexp((double)x, 64);
+}
+
+// 10^k * 2^64 * x, rounded half up, k = -1..2 (x * 2^64 is v64)
+static uint64_t round_decimals(u128 v64, int8_t k)
+{
+    if (k < 0)
+        return (uint64_t)((v64 + ((u128)5 << 64)) / ((u128)10 << 64));
+    u128 p = 1;
+    for (int8_t i = 0; i < k; i++)
+        p *= 10;
+    return (uint64_t)((v64 * p + ((u128)1 << 63)) >> 64);
+}
+
+// The text of dtostrf(x, 0, 2) in 1/100: 2 decimals, fewer when the integer
+// part has more than 6 digits (8 significant digits at most)
+static uint64_t dtostrf_centi(float x)
+{
+    u128 v64 = float_scaled64(x);
+    int8_t k = (x < 1e6F) ? 2 : (x < 1e7F) ? 1 : (x < 1e8F) ? 0 : -1;
+    uint64_t r = round_decimals(v64, k);
+    return (k == 2) ? r : (k == 1) ? r * 10 : (k == 0) ? r * 100 : r * 1000;
+}
+
+// tword -> freq, scale 100 * 2^64 per Hz
+static void check_tword(uint32_t tword, const Dds::FrequencyConverter &conv, Stat *st)
+{
+    u128 exact = (u128)tword * clock_hz * 100 << 32;
+    uint64_t floor100 = (uint64_t)(((u128)tword * clock_hz * 100) >> 32);
+    uint64_t nearest100 = (uint64_t)(((u128)tword * clock_hz * 100 + ((u128)1 << 31)) >> 32);
+
+    float freqf = (float)tword * (float)clock_hz / UINT32_MAX;
+    st[T_FLOAT].add(tword, (s128)(float_scaled64(freqf) * 100) - (s128)exact, -1, -1);
+
+    uint64_t text = dtostrf_centi(freqf);
+    st[T_DTOSTRF].add(tword, (s128)((u128)text << 64) - (s128)exact, text == floor100, text == nearest100);
+
+    Dds::Frequency f = conv.convert(tword);
+    uint64_t c = (uint64_t)f.hz * 100 + f.centi;
+    st[T_INT100].add(tword, (s128)((u128)c << 64) - (s128)exact, c == floor100, c == nearest100);
+}
+
+// freq -> tword, scale 100 * clock per tword LSB
+static void check_freq(uint32_t freq100, const Dds::TuningWordConverter &conv, Stat *st)
+{
+    uint64_t d = (uint64_t)clock_hz * 100;
+    uint64_t exact = (uint64_t)freq100 << 32;
+    uint64_t floor_tw = exact / d;
+    uint64_t nearest_tw = floor_tw + ((exact - floor_tw * d) * 2 >= d);
+
+    float freqf = freq100 / 100.0F;
+    uint32_t tw = freqf * UINT32_MAX / clock_hz;
+    st[F_FLOAT].add(freq100, (s128)((u128)tw * d) - (s128)exact, tw == floor_tw, tw == nearest_tw);
+
+    tw = conv.from_hz100(freq100);
+    st[F_INT100].add(freq100, (s128)((u128)tw * d) - (s128)exact, tw == floor_tw, tw == nearest_tw);
+
+    Fp::Fp32s freqfp = Fp::Fp32s((int32_t)(freq100 / 100), freq100 % 100, 100, 7);
+    tw = conv.from_fp(freqfp);
+    st[F_FP].add(freq100, (s128)((u128)tw * d) - (s128)exact, tw == floor_tw, tw == nearest_tw);
+}
+
+// Inputs still to do of one thread: [next, end) of the index space
+// 0..tword_count + freq_count (the tword inputs first)
+struct Range {
+    std::mutex m;
+    uint64_t next;
+    uint64_t end;
+};
+
+static std::vector<Range *> ranges;
+
+// [begin, end) to do next by thread id: its own chunk or a stolen half
+static bool take(size_t id, uint64_t &begin, uint64_t &end)
+{
+    Range &own = *ranges[id];
+    {
+        std::lock_guard<std::mutex> lock(own.m);
+        if (own.next < own.end) {
+            begin = own.next;
+            end = (own.end - own.next > CHUNK) ? own.next + CHUNK : own.end;
+            own.next = end;
+            return true;
+        }
+    }
+    for (;;) {
+        size_t victim = id;
+        uint64_t left = 0;
+        for (size_t i = 0; i < ranges.size(); i++) {
+            std::lock_guard<std::mutex> lock(ranges[i]->m);
+            if (ranges[i]->end - ranges[i]->next > left) {
+                left = ranges[i]->end - ranges[i]->next;
+                victim = i;
+            }
+        }
+        if (left == 0)
+            return false;
+        uint64_t stolen_end;
+        {
+            Range &r = *ranges[victim];
+            std::lock_guard<std::mutex> lock(r.m);
+            if (r.next == r.end)
+                continue;  // taken meanwhile
+            begin = (r.end - r.next <= CHUNK) ? r.next : r.next + (r.end - r.next) / 2;
+            stolen_end = r.end;
+            r.end = begin;
+        }
+        // one chunk now, the rest of the stolen half is the thief's own range
+        // (one lock at a time, so no thread waits for another in a cycle)
+        end = (stolen_end - begin > CHUNK) ? begin + CHUNK : stolen_end;
+        std::lock_guard<std::mutex> lock(own.m);
+        own.next = end;
+        own.end = stolen_end;
+        return true;
+    }
+}
+
+static void worker(size_t id, Stat *st)
+{
+    const Dds::FrequencyConverter freq_conv(clock_hz);
+    const Dds::TuningWordConverter tword_conv(clock_hz);
+    uint64_t begin, end;
+    while (take(id, begin, end)) {
+        for (uint64_t i = begin; i < end; i++) {
+            if (i < tword_count)
+                check_tword((uint32_t)(i * stride), freq_conv, st);
+            else
+                check_freq((uint32_t)((i - tword_count) * stride), tword_conv, st);
+        }
+    }
+}
+
+static void print_stats(const Stat *st, int first, int last, double scale, const char *unit)
+{
+    printf("%-14s %14s %14s %14s %12s %12s %12s\n",
+           "method", "max err", "mean err", "bias", "worst input", "!= floor", "!= nearest");
+    for (int m = first; m <= last; m++) {
+        const Stat &s = st[m];
+        long double n = (long double)s.count;
+        char floor_txt[24], nearest_txt[24];
+        if (m == T_FLOAT) {
+            strcpy(floor_txt, "-");
+            strcpy(nearest_txt, "-");
+        } else {
+            sprintf(floor_txt, "%llu", (unsigned long long)s.off_floor);
+            sprintf(nearest_txt, "%llu", (unsigned long long)s.off_nearest);
+        }
+        printf("%-14s %14.6Lg %14.6Lg %14.6Lg %12llu %12s %12s\n", method_name[m],
+               (long double)s.max_err / scale, (long double)s.sum_err / n / scale,
+               (long double)s.sum_signed / n / scale, (unsigned long long)s.worst, floor_txt, nearest_txt);
+    }
+    printf("(errors in %s)\n", unit);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t threads = std::thread::hardware_concurrency();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--clock") == 0)
+            clock_hz = strtoul(argv[i + 1], 0, 10);
+        else if (strcmp(argv[i], "--threads") == 0)
+            threads = strtoul(argv[i + 1], 0, 10);
+        else if (strcmp(argv[i], "--stride") == 0)
+            stride = strtoull(argv[i + 1], 0, 10);
+        else
+            break;
+    }
+    if (argc % 2 == 0 || clock_hz < 2 || stride == 0) {
+        fprintf(stderr, "usage: %s [--clock HZ (>= 2)] [--threads N] [--stride N]\n", argv[0]);
+        return 2;
+    }
+    if (threads == 0)
+        threads = 1;
+    // every tword, every freq100 below 2^32 and below the clock (tword < 2^32)
+    uint64_t freq_end = (uint64_t)clock_hz * 100;
+    if (freq_end > 0x100000000ULL)
+        freq_end = 0x100000000ULL;
+    tword_count = (0x100000000ULL + stride - 1) / stride;
+    freq_count = (freq_end + stride - 1) / stride;
+
+    uint64_t total = tword_count + freq_count;
+    for (size_t t = 0; t < threads; t++) {
+        Range *r = new Range;
+        r->next = total * t / threads;
+        r->end = total * (t + 1) / threads;
+        ranges.push_back(r);
+    }
+    std::vector<std::vector<Stat> > stats(threads, std::vector<Stat>(METHODS));
+    std::vector<std::thread> pool;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; t++)
+        pool.push_back(std::thread(worker, t, stats[t].data()));
+    for (size_t t = 0; t < threads; t++)
+        pool[t].join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    Stat st[METHODS];
+    for (size_t t = 0; t < threads; t++)
+        for (int m = 0; m < METHODS; m++)
+            st[m].merge(stats[t][m]);
+
+    printf("clock %lu Hz, %zu threads, %.1f s\n\n", (unsigned long)clock_hz, threads, secs);
+    printf("tword -> freq: %llu twords (stride %llu)\n",
+           (unsigned long long)tword_count, (unsigned long long)stride);
+    print_stats(st, T_FLOAT, T_INT100, 100.0 * 18446744073709551616.0, "Hz, floor/nearest in 1/100 Hz");
+    printf("\nfreq -> tword: %llu frequencies in 1/100 Hz below %llu (stride %llu)\n",
+           (unsigned long long)freq_count, (unsigned long long)freq_end, (unsigned long long)stride);
+    print_stats(st, F_FLOAT, F_FP, 100.0 * clock_hz, "tword LSB");
+    return 0;
+}
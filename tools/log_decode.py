@@ -0,0 +1,340 @@
+#!/usr/bin/env python3
+"""Decodes the binary stream of lib/logging (Log.Init(..., binary = true) or
+a LOG_TOKENIZED build) back into the text the normal mode prints.
+
+Binary records carry the flash address of the F() format, the formats are
+read from the .elf the firmware was built from. Tokenized records carry the
+token of the LOG_FMT() format, the formats come from the dictionary made by
+tools/log_tokens.py. E.g.
+
+    stty -F /dev/ttyACM0 38400 raw
+    tools/log_decode.py --elf .pioenvs/uno/firmware.elf /dev/ttyACM0
+    tools/log_decode.py --tokens tokens.csv capture.bin
+
+Dump records (Log.Dump) need neither. In a text log they come from
+LOG_DUMP_RAW, --text copies the text around them:
+
+    tools/log_decode.py --text capture.txt
+
+Without a stream file stdin is read.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+REC_SYNC = 0xA5
+REC_LEVEL = 0x07
+REC_TS = 0x08
+REC_INLINE = 0x10
+REC_LN = 0x20
+REC_TOKEN = 0x40
+REC_DUMP = 0x80
+
+DUMP_BIN = 0
+DUMP_HEX = 1
+DUMP_BYTES = 2
+DUMP_RAW = 3
+
+LEVEL_NOOUTPUT = 0
+LEVEL_ERRORS = 1
+
+TS_MICROS = 2
+TS_DELTA = 4
+
+# AVR data addresses start at 0x800000 in the .elf
+FLASH_END = 0x800000
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 2
+
+
+def load_flash(elf_path):
+    """Flash image (bytearray from address 0) of a 32-bit little endian .elf."""
+    with open(elf_path, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[4] != 1 or elf[5] != 1:
+        raise ValueError('%s: not a 32-bit little endian ELF file' % elf_path)
+    shoff, = struct.unpack_from('<I', elf, 0x20)
+    shentsize, shnum = struct.unpack_from('<HH', elf, 0x2E)
+    image = bytearray()
+    for i in range(shnum):
+        _, sh_type, flags, addr, offset, size = struct.unpack_from(
+            '<IIIIII', elf, shoff + i * shentsize)
+        if sh_type != SHT_PROGBITS or not flags & SHF_ALLOC or addr >= FLASH_END:
+            continue
+        if len(image) < addr + size:
+            image.extend(bytes(addr + size - len(image)))
+        image[addr:addr + size] = elf[offset:offset + size]
+    return image
+
+
+def c_string(data, pos):
+    """Text up to '\\0' and the position after it."""
+    end = data.find(b'\0', pos)
+    if end < 0:
+        end = len(data)
+    return data[pos:end], end + 1
+
+
+class Args:
+    """Argument bytes of a binary record, read in the order of the format."""
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt, size):
+        if self.pos + size > len(self.data):
+            raise IndexError
+        v, = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return v
+
+    def int(self):
+        return self.take('<i', 4)
+
+    def byte(self):
+        return self.take('<B', 1)
+
+    def long(self):
+        return self.take('<i', 4)
+
+    def ulong(self):
+        return self.take('<I', 4)
+
+    def int64(self):
+        return self.take('<q', 8)
+
+    def uint64(self):
+        return self.take('<Q', 8)
+
+    def fix32(self):
+        return self.int(), self.byte()
+
+    def fix64(self):
+        return self.int64(), self.byte()
+
+    def string(self):
+        if self.pos >= len(self.data):
+            raise IndexError
+        s, self.pos = c_string(self.data, self.pos)
+        return s
+
+
+class TokenArgs(Args):
+    """Arguments of a tokenized record: varints, zigzag for the signed ones."""
+
+    def varint(self):
+        v = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            v |= (b & 0x7f) << shift
+            shift += 7
+            if b < 0x80:
+                return v
+
+    def int(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    long = int
+    int64 = int
+
+    def ulong(self):
+        return self.varint()
+
+    uint64 = ulong
+
+
+def fix_text(value, digits):
+    """LogLine::fix32/fix64: raw / 2^q with digits decimals, rounded half
+    away from zero, default round(q * log10(2)) up to 9."""
+    raw, q = value
+    if digits is None:
+        digits = min(9, (q * 77 + 128) >> 8)
+    n = (2 * abs(raw) * 10 ** digits + (1 << q)) >> (q + 1)
+    text = b'-' if raw < 0 else b''
+    text += b'%d' % (n // 10 ** digits)
+    if digits:
+        text += b'.%0*d' % (digits, n % 10 ** digits)
+    return text
+
+
+def format_text(fmt, args):
+    """Logging::print of fmt, the text stops at the first missing argument."""
+    out = bytearray()
+    i = 0
+    try:
+        while i < len(fmt):
+            c = fmt[i:i + 1]
+            i += 1
+            if c != b'%':
+                out += c
+                continue
+            if i >= len(fmt):
+                break
+            c = fmt[i:i + 1]
+            i += 1
+            digits = None
+            if c.isdigit() and fmt[i:i + 1] in (b'q', b'Q'):
+                digits = int(c)
+                c = fmt[i:i + 1]
+                i += 1
+            if c == b'%':
+                out += c
+            elif c == b's':
+                out += args.string()
+            elif c in b'dic':
+                out += b'%d' % args.int()
+            elif c == b'x':
+                out += b'%X' % (args.int() & 0xffffffff)
+            elif c == b'X':
+                out += b'0x%X' % (args.int() & 0xffffffff)
+            elif c == b'b':
+                out += bin(args.int() & 0xffffffff)[2:].encode()
+            elif c == b'B':
+                out += b'0b' + bin(args.int() & 0xffffffff)[2:].encode()
+            elif c == b'y':
+                out += format(args.byte(), '08b').encode()
+            elif c == b'Y':
+                out += b'0b' + format(args.byte(), '08b').encode()
+            elif c == b'l':
+                out += b'%d' % args.long()
+            elif c == b'u':
+                out += b'%d' % args.ulong()
+            elif c == b'L':
+                out += b'%d' % args.int64()
+            elif c == b'U':
+                out += b'%d' % args.uint64()
+            elif c == b'H':
+                out += b'%X' % args.uint64()
+            elif c == b't':
+                out += b'T' if args.int() == 1 else b'F'
+            elif c == b'T':
+                out += b'true' if args.int() == 1 else b'false'
+            elif c == b'q':
+                out += fix_text(args.fix32(), digits)
+            elif c == b'Q':
+                out += fix_text(args.fix64(), digits)
+    except IndexError:
+        pass
+    return bytes(out)
+
+
+def dump_text(view, data):
+    """Logging::dump of the bytes (already in the order of the view),
+    LOG_DUMP_RAW is shown as LOG_DUMP_BYTES."""
+    if view == DUMP_BIN:
+        return b'-'.join(format(b, '08b').encode() for b in data)
+    if view == DUMP_HEX:
+        return b''.join(b'%02X' % b for b in data)
+    return b' '.join(b'%02X' % b for b in data)
+
+
+def load_tokens(csv_path):
+    """Token dictionary of tools/log_tokens.py."""
+    with open(csv_path, encoding='latin-1', newline='') as f:
+        return {int(t, 16): fmt.encode('latin-1') for t, fmt in csv.reader(f)}
+
+
+def ts_text(session, t):
+    """Logging::print_ts of the time stamp t in the mode of the session."""
+    mode = session.get('ts', 1)
+    return b'%s%010d %s: ' % (b'+' if mode & TS_DELTA else b'', t,
+                              b'us' if mode & TS_MICROS else b'ms')
+
+
+def decode_record(rec, formats, session):
+    """Text of one record (without sync and length bytes).
+
+    formats - flash image for binary records or token dictionary,
+    session - state of the stream, the time stamp mode of the session record."""
+    flags = rec[0]
+    pos = 1
+    out = b''
+    if flags & REC_LEVEL == LEVEL_NOOUTPUT:
+        session['ts'] = rec[1]
+        return out
+    if flags & REC_LEVEL == LEVEL_ERRORS:
+        out += b'ERROR: '
+    if flags & REC_DUMP:
+        if flags & REC_TS:
+            out += ts_text(session, struct.unpack_from('<I', rec, pos)[0])
+            pos += 4
+        view = rec[pos]
+        label, pos = c_string(rec, pos + 1)
+        out += label + b': ' + dump_text(view, rec[pos:])
+        return out + (b'\r\n' if flags & REC_LN else b'')
+    if flags & REC_TOKEN:
+        args = TokenArgs(rec[pos:])
+        if flags & REC_TS:
+            out += ts_text(session, args.varint())
+        t = args.take('<H', 2)
+        fmt = formats.get(t, b'<unknown token %04x>' % t)
+    else:
+        if flags & REC_TS:
+            out += ts_text(session, struct.unpack_from('<I', rec, pos)[0])
+            pos += 4
+        if flags & REC_INLINE:
+            fmt, pos = c_string(rec, pos)
+        else:
+            fmt, _ = c_string(formats, struct.unpack_from('<H', rec, pos)[0])
+            pos += 2
+        args = Args(rec[pos:])
+    out += format_text(fmt, args)
+    if flags & REC_LN:
+        out += b'\r\n'
+    return out
+
+
+def decode(stream, formats, session, text=False):
+    """Text of the complete records in stream and the number of bytes used,
+    bytes outside records are skipped (copied with text)."""
+    out = bytearray()
+    pos = 0
+    while True:
+        sync = stream.find(bytes([REC_SYNC]), pos)
+        if sync < 0:
+            if text:
+                out += stream[pos:]
+            return bytes(out), len(stream)
+        if text:
+            out += stream[pos:sync]
+        pos = sync
+        if pos + 2 > len(stream) or pos + 2 + stream[pos + 1] > len(stream):
+            return bytes(out), pos
+        end = pos + 2 + stream[pos + 1]
+        out += decode_record(stream[pos + 2:end], formats, session)
+        pos = end
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description='Decodes the binary log stream of lib/logging.')
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--elf', help='firmware .elf (binary records)')
+    source.add_argument('--tokens', help='token dictionary (tokenized records)')
+    source.add_argument('--text', action='store_true',
+                        help='text log with LOG_DUMP_RAW records, the text is copied')
+    parser.add_argument('stream', nargs='?', help='captured stream (default stdin)')
+    opt = parser.parse_args(argv[1:])
+    formats = load_flash(opt.elf) if opt.elf else load_tokens(opt.tokens) if opt.tokens else {}
+    f = open(opt.stream, 'rb') if opt.stream else sys.stdin.buffer
+    stream = b''
+    session = {}
+    while True:
+        chunk = f.read1(4096)
+        if not chunk:
+            break
+        text, used = decode(stream + chunk, formats, session, opt.text)
+        stream = (stream + chunk)[used:]
+        sys.stdout.buffer.write(text)
+        sys.stdout.buffer.flush()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
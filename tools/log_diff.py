@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Compares two text logs of the sketch, e.g. a capture in .log/ with the
+output of the host build:
+
+    pio run -e native_sketch && .pio/build/native_sketch/program > native.txt
+    tools/log_diff.py .log/ct05imp.txt native.txt
+
+The time stamps are board timings and do not take part ("0000003000 ms: "
+and the "TS: " of an edited header are removed). The captures in .log/ were
+saved with LF line ends and decimal commas, both sides are brought to CRLF
+-> LF and ',' -> '.' between digits. --columns keeps only some of the tab
+separated columns (1-based, e.g. 1-6 or 1,2,5), for captures older than a
+change of the sketch. Exit status is 1 if the logs differ.
+"""
+
+import argparse
+import difflib
+import re
+import sys
+
+TS = re.compile(r'^(\d{10} (ms|us)|TS): ')
+DECIMAL_COMMA = re.compile(r'(?<=\d),(?=\d)')
+
+
+def column_set(spec):
+    cols = set()
+    for part in spec.split(','):
+        first, _, last = part.partition('-')
+        cols.update(range(int(first), int(last or first) + 1))
+    return cols
+
+
+def normalize(path, cols):
+    with open(path, 'rb') as f:
+        text = f.read().decode('latin-1')
+    lines = []
+    for line in text.replace('\r\n', '\n').split('\n'):
+        line = DECIMAL_COMMA.sub('.', TS.sub('', line))
+        if cols:
+            fields = line.split('\t')
+            line = '\t'.join(f for i, f in enumerate(fields, 1) if i in cols)
+        lines.append(line + '\n')
+    if lines and lines[-1] == '\n':
+        lines.pop()
+    return lines
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description='Compares two text logs without their time stamps.')
+    parser.add_argument('--columns', help='tab separated columns to compare, e.g. 1-6')
+    parser.add_argument('expected', help='captured log, e.g. .log/ct05imp.txt')
+    parser.add_argument('actual', help='log to check')
+    opt = parser.parse_args(argv[1:])
+    cols = column_set(opt.columns) if opt.columns else None
+    diff = list(difflib.unified_diff(normalize(opt.expected, cols), normalize(opt.actual, cols),
+                                     opt.expected, opt.actual))
+    sys.stdout.writelines(diff)
+    return 1 if diff else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
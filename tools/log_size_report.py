@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Flash and RAM cost of the log call sites per compile-time LOGLEVEL.
+
+Builds the uno environment once per level (PlatformIO, -DLOGLEVEL=n) and
+reads the sizes of the firmware with avr-size, e.g.
+
+    tools/log_size_report.py            # from the project directory
+
+The cycles a disabled call site costs at runtime are measured on the board
+by bench_log() in src/math.cpp.
+"""
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+LEVELS = ['NOOUTPUT', 'ERRORS', 'INFOS', 'DEBUG', 'VERBOSE']
+SITE = re.compile(r'\bLOG_(ERROR|INFO|DEBUG|VERBOSE)\(')
+SITE_LEVEL = {'ERROR': 1, 'INFO': 2, 'DEBUG': 3, 'VERBOSE': 4}
+ELF_PATHS = ['.pio/build/uno/firmware.elf', '.pioenvs/uno/firmware.elf']
+
+
+def call_sites(src_dir):
+    """Number of LOG_xxx call sites per level in the sketch sources."""
+    count = [0] * len(LEVELS)
+    for root, _, files in os.walk(src_dir):
+        for name in files:
+            if name.endswith(('.c', '.cpp', '.h', '.ino')):
+                with open(os.path.join(root, name), encoding='latin-1') as f:
+                    for m in SITE.finditer(f.read()):
+                        count[SITE_LEVEL[m.group(1)]] += 1
+    return count
+
+
+def avr_size_cmd():
+    cmd = shutil.which('avr-size')
+    if cmd:
+        return cmd
+    pio = os.path.expanduser('~/.platformio/packages/toolchain-atmelavr/bin/avr-size')
+    if os.path.exists(pio):
+        return pio
+    raise SystemExit('avr-size not found')
+
+
+def build_size(level, size_cmd):
+    """(flash, ram) bytes of the firmware built with LOGLEVEL = level."""
+    env = dict(os.environ, PLATFORMIO_BUILD_FLAGS='-DLOGLEVEL=%d' % level)
+    subprocess.run(['pio', 'run', '-e', 'uno', '-s'], env=env, check=True)
+    elf = next(p for p in ELF_PATHS if os.path.exists(p))
+    out = subprocess.run([size_cmd, elf], capture_output=True, text=True, check=True).stdout
+    text, data, bss = (int(v) for v in out.splitlines()[1].split()[:3])
+    return text + data, data + bss
+
+
+def main():
+    size_cmd = avr_size_cmd()
+    sites = call_sites('src')
+    sizes = [build_size(level, size_cmd) for level in range(len(LEVELS))]
+    full = sizes[-1][0]
+    print('%-10s %6s %5s %6s %8s %8s' % ('LOGLEVEL', 'flash', 'ram', 'sites', 'saved', 'per site'))
+    for level, (flash, ram) in enumerate(sizes):
+        kept = sum(sites[:level + 1])
+        removed = sum(sites) - kept
+        per_site = '%8.1f' % ((full - flash) / removed) if removed else '%8s' % '-'
+        print('%-10s %6d %5d %6d %8d %s' % (LEVELS[level], flash, ram, kept, full - flash, per_site))
+    # leave the default build behind
+    subprocess.run(['pio', 'run', '-e', 'uno', '-s'], check=True)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Token dictionary of the tokenized log mode (lib/logging, LOG_TOKENIZED).
+
+Finds every LOG_FMT("...") and LOG_INFO("...", ...) (all levels) in the
+given files and directories and writes token,format lines (CSV) for
+tools/log_decode.py --tokens, e.g.
+
+    tools/log_tokens.py src lib > tokens.csv
+
+Fails when two different formats get the same token, reword one of them.
+"""
+
+import csv
+import io
+import os
+import re
+import sys
+
+SOURCE_EXT = ('.c', '.cpp', '.h', '.hpp', '.ino')
+
+# LOG_FMT( or a level macro followed by one or more adjacent string literals
+LOG_FMT = re.compile(r'\bLOG_(?:FMT|ERROR|INFO|DEBUG|VERBOSE)\(\s*((?:"(?:[^"\\\n]|\\.)*"\s*)+)[,)]')
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+# comments are dropped, literals and character constants are kept as they are
+COMMENT = re.compile(r'"(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\'|//[^\n]*|/\*.*?\*/', re.S)
+ESCAPE = re.compile(r'\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)')
+SIMPLE_ESCAPES = {'n': 10, 't': 9, 'r': 13, '0': 0, 'a': 7, 'b': 8, 'f': 12,
+                  'v': 11, '\\': 92, '"': 34, "'": 39, '?': 63}
+
+
+def unescape(text):
+    """Bytes of the C string literal body text."""
+    out = bytearray()
+    pos = 0
+    for m in ESCAPE.finditer(text):
+        out += text[pos:m.start()].encode('latin-1')
+        e = m.group(1)
+        if e[0] == 'x':
+            out.append(int(e[1:], 16) & 0xff)
+        elif e[0] in '01234567':
+            out.append(int(e, 8) & 0xff)
+        else:
+            out.append(SIMPLE_ESCAPES.get(e, ord(e)))
+        pos = m.end()
+    out += text[pos:].encode('latin-1')
+    return bytes(out)
+
+
+def token(fmt):
+    """log_token() of Logging.h: FNV-1a folded to 16 bits."""
+    h = 2166136261
+    for b in fmt:
+        h = ((h ^ b) * 16777619) & 0xffffffff
+    return (h >> 16) ^ (h & 0xffff)
+
+
+def source_files(paths):
+    for path in paths:
+        if os.path.isfile(path):
+            yield path
+            continue
+        for root, dirs, files in os.walk(path):
+            dirs.sort()
+            for name in sorted(files):
+                if name.endswith(SOURCE_EXT):
+                    yield os.path.join(root, name)
+
+
+def formats(paths):
+    for name in source_files(paths):
+        with open(name, encoding='latin-1') as f:
+            text = COMMENT.sub(lambda m: ' ' if m.group(0)[0] == '/' else m.group(0), f.read())
+        for m in LOG_FMT.finditer(text):
+            yield name, b''.join(unescape(l) for l in LITERAL.findall(m.group(1)))
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write(__doc__)
+        return 2
+    tokens = {}
+    ok = True
+    for name, fmt in formats(argv[1:]):
+        t = token(fmt)
+        if tokens.setdefault(t, fmt) != fmt:
+            sys.stderr.write('%s: token %04x of "%s" is already used by "%s"\n'
+                             % (name, t, fmt.decode('latin-1'), tokens[t].decode('latin-1')))
+            ok = False
+    stdout = io.TextIOWrapper(sys.stdout.buffer, encoding='latin-1', newline='')
+    out = csv.writer(stdout, lineterminator='\n')
+    for t in sorted(tokens):
+        out.writerow(['%04x' % t, tokens[t].decode('latin-1')])
+    stdout.flush()
+    stdout.detach()
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))